@@ -7,11 +7,13 @@
 #include <chainparams.h>
 #include <common/args.h>
 #include <consensus/validation.h>
+#include <crypto/sha256.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
 #include <serialize.h>
 #include <span.h>
 #include <streams.h>
+#include <tinyformat.h>
 #include <util/chaintype.h>
 #include <validation.h>
 
@@ -39,6 +41,53 @@ static void DeserializeBlockTest(benchmark::Bench& bench)
     });
 }
 
+/** Deserialize the transactions of a block with their hashes computed one at a
+ *  time, or all together with MakeTransactionRefs(), regardless of the choice
+ *  TransactionsFormatter makes for the SHA256 implementation in use. */
+static void DeserializeBlockTransactions(benchmark::Bench& bench, bool batched, sha256_implementation::UseImplementation use_implementation)
+{
+    bench.name(strprintf("%s using the '%s' SHA256 implementation", bench.name(), SHA256AutoDetect(use_implementation)));
+    DataStream stream(benchmark::data::block413567);
+    std::byte a{0};
+    stream.write({&a, 1}); // Prevent compaction
+
+    bench.unit("block").run([&] {
+        CBlockHeader header;
+        stream >> header;
+        std::vector<CTransactionRef> txs;
+        if (batched) {
+            std::vector<CMutableTransaction> mtxs;
+            stream >> TX_WITH_WITNESS(mtxs);
+            txs = MakeTransactionRefs(std::move(mtxs));
+        } else {
+            stream >> TX_WITH_WITNESS(txs);
+        }
+        bool rewound = stream.Rewind(benchmark::data::block413567.size());
+        assert(rewound);
+    });
+    SHA256AutoDetect();
+}
+
+static void DeserializeBlockTxHashesPerTx(benchmark::Bench& bench)
+{
+    DeserializeBlockTransactions(bench, /*batched=*/false, sha256_implementation::USE_ALL);
+}
+
+static void DeserializeBlockTxHashesBatched(benchmark::Bench& bench)
+{
+    DeserializeBlockTransactions(bench, /*batched=*/true, sha256_implementation::USE_ALL);
+}
+
+static void DeserializeBlockTxHashesPerTxAVX2(benchmark::Bench& bench)
+{
+    DeserializeBlockTransactions(bench, /*batched=*/false, sha256_implementation::USE_SSE4_AND_AVX2);
+}
+
+static void DeserializeBlockTxHashesBatchedAVX2(benchmark::Bench& bench)
+{
+    DeserializeBlockTransactions(bench, /*batched=*/true, sha256_implementation::USE_SSE4_AND_AVX2);
+}
+
 static void DeserializeAndCheckBlockTest(benchmark::Bench& bench)
 {
     DataStream stream(benchmark::data::block413567);
@@ -61,4 +110,8 @@ static void DeserializeAndCheckBlockTest(benchmark::Bench& bench)
 }
 
 BENCHMARK(DeserializeBlockTest);
+BENCHMARK(DeserializeBlockTxHashesPerTx);
+BENCHMARK(DeserializeBlockTxHashesBatched);
+BENCHMARK(DeserializeBlockTxHashesPerTxAVX2);
+BENCHMARK(DeserializeBlockTxHashesBatchedAVX2);
 BENCHMARK(DeserializeAndCheckBlockTest);
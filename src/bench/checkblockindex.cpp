@@ -3,10 +3,19 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bench/bench.h>
+#include <chain.h>
+#include <dbwrapper.h>
+#include <node/blockstorage.h>
+#include <node/kernel_notifications.h>
+#include <primitives/block.h>
+#include <sync.h>
 #include <test/util/setup_common.h>
+#include <util/check.h>
 #include <validation.h>
 
+#include <cassert>
 #include <memory>
+#include <vector>
 
 static void CheckBlockIndex(benchmark::Bench& bench)
 {
@@ -18,5 +27,40 @@ static void CheckBlockIndex(benchmark::Bench& bench)
     });
 }
 
+//! Build the block index of a fresh BlockManager from the headers of a chain,
+//! as done when loading the index from disk or syncing headers.
+static void AddToBlockIndex(benchmark::Bench& bench)
+{
+    auto testing_setup{MakeNoLogFileContext<TestChain100Setup>()};
+    testing_setup->mineBlocks(1000);
+    std::vector<CBlockHeader> headers;
+    {
+        LOCK(cs_main);
+        const CChain& chain{testing_setup->m_node.chainman->ActiveChain()};
+        for (const CBlockIndex* index{chain.Genesis()}; index; index = chain.Next(index)) {
+            headers.push_back(index->GetBlockHeader());
+        }
+    }
+    const node::BlockManager::Options blockman_opts{
+        .chainparams = testing_setup->m_node.chainman->GetParams(),
+        .blocks_dir = testing_setup->m_args.GetBlocksDirPath(),
+        .notifications = *testing_setup->m_node.notifications,
+        .block_tree_db_params = DBParams{
+            .path = testing_setup->m_args.GetDataDirNet() / "blocks" / "index",
+            .cache_bytes = 0,
+            .memory_only = true,
+        },
+    };
+    bench.run([&] {
+        node::BlockManager blockman{*Assert(testing_setup->m_node.shutdown_signal), blockman_opts};
+        CBlockIndex* best_header{nullptr};
+        LOCK(cs_main);
+        for (const CBlockHeader& header : headers) {
+            blockman.AddToBlockIndex(header, best_header);
+        }
+        assert(best_header->nHeight == int(headers.size()) - 1);
+    });
+}
 
 BENCHMARK(CheckBlockIndex);
+BENCHMARK(AddToBlockIndex);
@@ -5,13 +5,18 @@
 #include <bench/bench.h>
 #include <checkqueue.h>
 #include <common/system.h>
+#include <crypto/sha256.h>
 #include <key.h>
 #include <prevector.h>
 #include <random.h>
 #include <script/script.h>
+#include <tinyformat.h>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -66,3 +71,50 @@ static void CCheckQueueSpeedPrevectorJob(benchmark::Bench& bench)
     });
 }
 BENCHMARK(CCheckQueueSpeedPrevectorJob);
+
+// Sweep the number of threads and the cost of a single check, to compare how
+// the schedulers cope with lock contention (cheap checks, e.g. a block full of
+// small taproot spends) and with load balancing (expensive checks).
+static void CCheckQueueScheduling(benchmark::Bench& bench, CheckQueueScheduler scheduler)
+{
+    if (GetNumCores() <= 1) return;
+
+    struct HashJob {
+        //! Number of SHA256 compressions to run, standing in for the cost of a script check.
+        int rounds;
+        std::array<unsigned char, CSHA256::OUTPUT_SIZE> hash{};
+        std::optional<int> operator()()
+        {
+            for (int i{0}; i < rounds; ++i) {
+                CSHA256().Write(hash.data(), hash.size()).Finalize(hash.data());
+            }
+            return std::nullopt;
+        }
+    };
+
+    const std::string name{bench.name()};
+    std::vector<int> thread_counts;
+    for (int threads{1}; threads < GetNumCores(); threads *= 2) thread_counts.push_back(threads);
+    if (thread_counts.back() != GetNumCores() - 1) thread_counts.push_back(GetNumCores() - 1);
+
+    for (const int rounds : {1, 16, 256}) {
+        const std::vector<std::vector<HashJob>> batches(BATCHES, std::vector<HashJob>(BATCH_SIZE, HashJob{rounds}));
+        for (const int worker_threads_num : thread_counts) {
+            CCheckQueue<HashJob> queue{QUEUE_BATCH_SIZE, worker_threads_num, scheduler};
+            bench.name(strprintf("%s, %d worker threads, %d hashes per check", name, worker_threads_num, rounds))
+                .batch(BATCH_SIZE * BATCHES).unit("job").run([&] {
+                    CCheckQueueControl<HashJob> control(queue);
+                    for (auto checks : batches) {
+                        control.Add(std::move(checks));
+                    }
+                    control.Complete();
+                });
+        }
+    }
+}
+
+static void CCheckQueueSharedQueue(benchmark::Bench& bench) { CCheckQueueScheduling(bench, CheckQueueScheduler::SHARED_QUEUE); }
+static void CCheckQueueWorkStealing(benchmark::Bench& bench) { CCheckQueueScheduling(bench, CheckQueueScheduler::WORK_STEALING); }
+
+BENCHMARK(CCheckQueueSharedQueue);
+BENCHMARK(CCheckQueueWorkStealing);
@@ -4,14 +4,20 @@
 
 #include <addresstype.h>
 #include <bench/bench.h>
+#include <coins.h>
+#include <inputfetcher.h>
 #include <interfaces/chain.h>
 #include <kernel/cs_main.h>
 #include <script/interpreter.h>
+#include <script/sign.h>
+#include <script/signingprovider.h>
 #include <sync.h>
 #include <test/util/setup_common.h>
+#include <util/translation.h>
 #include <validation.h>
 
 #include <cassert>
+#include <map>
 #include <vector>
 
 /*
@@ -89,9 +95,8 @@ std::pair<std::vector<CKey>, std::vector<CTxOut>> CreateKeysAndOutputs(const CKe
     return {keys, outputs};
 }
 
-void BenchmarkConnectBlock(benchmark::Bench& bench, std::vector<CKey>& keys, std::vector<CTxOut>& outputs, TestChain100Setup& test_setup)
+void BenchmarkConnectBlock(benchmark::Bench& bench, const CBlock& test_block, TestChain100Setup& test_setup)
 {
-    const auto& test_block{CreateTestBlock(test_setup, keys, outputs)};
     bench.unit("block").run([&] {
         LOCK(cs_main);
         auto& chainman{test_setup.m_node.chainman};
@@ -104,6 +109,130 @@ void BenchmarkConnectBlock(benchmark::Bench& bench, std::vector<CKey>& keys, std
     });
 }
 
+void BenchmarkConnectBlock(benchmark::Bench& bench, std::vector<CKey>& keys, std::vector<CTxOut>& outputs, TestChain100Setup& test_setup)
+{
+    BenchmarkConnectBlock(bench, CreateTestBlock(test_setup, keys, outputs), test_setup);
+}
+
+/*
+ * Mines a block with a transaction that splits the first coinbase output into
+ * num_outputs outputs of equal value paying to spk, and returns that transaction.
+ */
+CTransactionRef CreateFundingTx(TestChain100Setup& test_setup, size_t num_outputs, const CScript& spk)
+{
+    Chainstate& chainstate{test_setup.m_node.chainman->ActiveChainstate()};
+
+    auto& coinbase_to_spend{test_setup.m_coinbase_txns[0]};
+    const CAmount value{coinbase_to_spend->vout[0].nValue / CAmount(num_outputs + 1)};
+    const auto [funding_tx, _]{test_setup.CreateValidTransaction(
+        {coinbase_to_spend},
+        {COutPoint(coinbase_to_spend->GetHash(), 0)},
+        chainstate.m_chain.Height() + 1, {test_setup.coinbaseKey},
+        std::vector<CTxOut>(num_outputs, CTxOut{value, spk}), {}, {})};
+    test_setup.CreateAndProcessBlock({funding_tx}, spk, &chainstate);
+    return MakeTransactionRef(funding_tx);
+}
+
+/*
+ * Creates a test block whose transactions spend Taproot outputs through the
+ * script path:
+ * - Every output commits to a single <key> OP_CHECKSIG leaf under an
+ *   unspendable internal key, so key path spends are impossible
+ * - A funding transaction with num_inputs such outputs is mined first, see
+ *   CreateFundingTx()
+ * - Each transaction of the test block spends two of the funding outputs
+ */
+CBlock CreateScriptPathTestBlock(TestChain100Setup& test_setup, size_t num_inputs)
+{
+    Chainstate& chainstate{test_setup.m_node.chainman->ActiveChainstate()};
+
+    const CKey key{GenerateRandomKey()};
+    TaprootBuilder builder;
+    builder.Add(/*depth=*/0, CScript() << ToByteVector(XOnlyPubKey{key.GetPubKey()}) << OP_CHECKSIG, TAPROOT_LEAF_TAPSCRIPT);
+    builder.Finalize(XOnlyPubKey::NUMS_H);
+    const WitnessV1Taproot output{builder.GetOutput()};
+    const CScript spk{GetScriptForDestination(output)};
+    FlatSigningProvider provider;
+    provider.keys.emplace(key.GetPubKey().GetID(), key);
+    provider.tr_trees.emplace(output, builder);
+
+    const CTransactionRef funding_ref{CreateFundingTx(test_setup, num_inputs, spk)};
+    const CAmount value{funding_ref->vout[0].nValue};
+    std::vector<CMutableTransaction> txs;
+    txs.reserve(num_inputs / 2);
+    for (uint32_t i{0}; i + 1 < num_inputs; i += 2) {
+        CMutableTransaction tx;
+        std::map<COutPoint, Coin> coins;
+        for (const uint32_t n : {i, i + 1}) {
+            const COutPoint outpoint{funding_ref->GetHash(), n};
+            tx.vin.emplace_back(outpoint);
+            coins.emplace(outpoint, Coin{funding_ref->vout[n], chainstate.m_chain.Height(), /*fCoinBaseIn=*/false});
+        }
+        tx.vout.emplace_back(value, spk);
+        std::map<int, bilingual_str> input_errors;
+        assert(SignTransaction(tx, &provider, coins, SIGHASH_DEFAULT, input_errors));
+        txs.emplace_back(std::move(tx));
+    }
+
+    return test_setup.CreateBlock(txs, spk, chainstate);
+}
+
+/*
+ * Creates a test block whose inputs were all created in an earlier block, so
+ * none of them can be resolved from within the test block itself:
+ * - A funding transaction with num_inputs P2WPKH outputs is mined first, see
+ *   CreateFundingTx()
+ * - Each transaction of the test block spends two of the funding outputs
+ */
+CBlock CreateColdInputsTestBlock(TestChain100Setup& test_setup, size_t num_inputs)
+{
+    Chainstate& chainstate{test_setup.m_node.chainman->ActiveChainstate()};
+
+    const CKey key{GenerateRandomKey()};
+    const CScript spk{GetScriptForDestination(WitnessV0KeyHash{key.GetPubKey()})};
+
+    const CTransactionRef funding_ref{CreateFundingTx(test_setup, num_inputs, spk)};
+    const CAmount value{funding_ref->vout[0].nValue};
+    std::vector<CMutableTransaction> txs;
+    txs.reserve(num_inputs / 2);
+    for (uint32_t i{0}; i + 1 < num_inputs; i += 2) {
+        const auto [tx, _]{test_setup.CreateValidTransaction(
+            {funding_ref},
+            {COutPoint(funding_ref->GetHash(), i), COutPoint(funding_ref->GetHash(), i + 1)},
+            chainstate.m_chain.Height() + 1, {key}, {CTxOut{value, spk}}, {}, {})};
+        txs.emplace_back(tx);
+    }
+
+    return test_setup.CreateBlock(txs, spk, chainstate);
+}
+
+/*
+ * Connects a block against an on-disk chainstate whose coins cache doesn't
+ * hold any of the block's inputs, optionally warming the cache with an
+ * InputFetcher first. Inputs are evicted from the cache after every run.
+ */
+void BenchmarkConnectBlockColdCache(benchmark::Bench& bench, int fetch_threads)
+{
+    const auto test_setup{MakeNoLogFileContext<TestChain100Setup>(ChainType::REGTEST, {.coins_db_in_memory = false})};
+    const auto& test_block{CreateColdInputsTestBlock(*test_setup, /*num_inputs=*/2000)};
+    auto& chainman{*test_setup->m_node.chainman};
+    auto& chainstate{chainman.ActiveChainstate()};
+    InputFetcher fetcher{fetch_threads};
+
+    LOCK(cs_main);
+    chainstate.ForceFlushStateToDisk(); // Write all coins to disk and empty the cache
+    auto* pindex{chainman.m_blockman.AddToBlockIndex(test_block, chainman.m_best_header)};
+    bench.unit("block").run([&] {
+        BlockValidationState test_block_state;
+        fetcher.FetchInputs(chainstate.CoinsTip(), chainstate.CoinsDB(), test_block);
+        CCoinsViewCache viewNew{&chainstate.CoinsTip()};
+        assert(chainstate.ConnectBlock(test_block, test_block_state, pindex, viewNew));
+        for (const auto& tx : test_block.vtx) {
+            for (const auto& txin : tx->vin) chainstate.CoinsTip().Uncache(txin.prevout);
+        }
+    });
+}
+
 static void ConnectBlockAllSchnorr(benchmark::Bench& bench)
 {
     const auto test_setup{MakeNoLogFileContext<TestChain100Setup>()};
@@ -111,6 +240,12 @@ static void ConnectBlockAllSchnorr(benchmark::Bench& bench)
     BenchmarkConnectBlock(bench, keys, outputs, *test_setup);
 }
 
+static void ConnectBlockSchnorrScriptPath(benchmark::Bench& bench)
+{
+    const auto test_setup{MakeNoLogFileContext<TestChain100Setup>()};
+    BenchmarkConnectBlock(bench, CreateScriptPathTestBlock(*test_setup, /*num_inputs=*/2000), *test_setup);
+}
+
 static void ConnectBlockMixedEcdsaSchnorr(benchmark::Bench& bench)
 {
     const auto test_setup{MakeNoLogFileContext<TestChain100Setup>()};
@@ -126,6 +261,19 @@ static void ConnectBlockAllEcdsa(benchmark::Bench& bench)
     BenchmarkConnectBlock(bench, keys, outputs, *test_setup);
 }
 
+static void ConnectBlockColdCache(benchmark::Bench& bench)
+{
+    BenchmarkConnectBlockColdCache(bench, /*fetch_threads=*/0);
+}
+
+static void ConnectBlockColdCachePrefetch(benchmark::Bench& bench)
+{
+    BenchmarkConnectBlockColdCache(bench, /*fetch_threads=*/4);
+}
+
 BENCHMARK(ConnectBlockAllSchnorr);
+BENCHMARK(ConnectBlockSchnorrScriptPath);
 BENCHMARK(ConnectBlockMixedEcdsaSchnorr);
 BENCHMARK(ConnectBlockAllEcdsa);
+BENCHMARK(ConnectBlockColdCache);
+BENCHMARK(ConnectBlockColdCachePrefetch);
@@ -181,6 +181,46 @@ static void SHA256D64_1024_SHANI(benchmark::Bench& bench)
     SHA256AutoDetect();
 }
 
+/** Double-SHA256 1000 variable-length inputs of typical transaction sizes, as done for the txids of a block. */
+static void SHA256DMany_1000(benchmark::Bench& bench, sha256_implementation::UseImplementation use_implementation)
+{
+    bench.name(strprintf("%s using the '%s' SHA256 implementation", bench.name(), SHA256AutoDetect(use_implementation)));
+    FastRandomContext rng{/*fDeterministic=*/true};
+    std::vector<std::vector<uint8_t>> txs(1000);
+    std::vector<std::span<const uint8_t>> inputs;
+    size_t total{0};
+    for (auto& tx : txs) {
+        tx = rng.randbytes(150 + rng.randrange(500));
+        inputs.emplace_back(tx);
+        total += tx.size();
+    }
+    std::vector<uint8_t> out(32 * inputs.size());
+    bench.batch(total).unit("byte").run([&] {
+        SHA256DMany(out.data(), inputs.data(), inputs.size());
+    });
+    SHA256AutoDetect();
+}
+
+static void SHA256DMany_1000_STANDARD(benchmark::Bench& bench)
+{
+    SHA256DMany_1000(bench, sha256_implementation::STANDARD);
+}
+
+static void SHA256DMany_1000_SSE4(benchmark::Bench& bench)
+{
+    SHA256DMany_1000(bench, sha256_implementation::USE_SSE4);
+}
+
+static void SHA256DMany_1000_AVX2(benchmark::Bench& bench)
+{
+    SHA256DMany_1000(bench, sha256_implementation::USE_SSE4_AND_AVX2);
+}
+
+static void SHA256DMany_1000_SHANI(benchmark::Bench& bench)
+{
+    SHA256DMany_1000(bench, sha256_implementation::USE_SSE4_AND_SHANI);
+}
+
 static void SHA512(benchmark::Bench& bench)
 {
     uint8_t hash[CSHA512::OUTPUT_SIZE];
@@ -203,6 +243,23 @@ static void SipHash_32b(benchmark::Bench& bench)
     });
 }
 
+static void SipHash_32b_Batch(benchmark::Bench& bench)
+{
+    FastRandomContext rng{/*fDeterministic=*/true};
+    PresaltedSipHasher presalted_sip_hasher(rng.rand64(), rng.rand64());
+    std::vector<uint256> vals(1000);
+    std::vector<const uint256*> ptrs;
+    for (auto& val : vals) {
+        val = rng.rand256();
+        ptrs.push_back(&val);
+    }
+    std::vector<uint64_t> out(vals.size());
+    bench.batch(vals.size()).unit("hash").run([&] {
+        presalted_sip_hasher(ptrs, out);
+        ankerl::nanobench::doNotOptimizeAway(out);
+    });
+}
+
 static void MuHash(benchmark::Bench& bench)
 {
     MuHash3072 acc;
@@ -274,10 +331,15 @@ BENCHMARK(SHA256_32b_SSE4);
 BENCHMARK(SHA256_32b_AVX2);
 BENCHMARK(SHA256_32b_SHANI);
 BENCHMARK(SipHash_32b);
+BENCHMARK(SipHash_32b_Batch);
 BENCHMARK(SHA256D64_1024_STANDARD);
 BENCHMARK(SHA256D64_1024_SSE4);
 BENCHMARK(SHA256D64_1024_AVX2);
 BENCHMARK(SHA256D64_1024_SHANI);
+BENCHMARK(SHA256DMany_1000_STANDARD);
+BENCHMARK(SHA256DMany_1000_SSE4);
+BENCHMARK(SHA256DMany_1000_AVX2);
+BENCHMARK(SHA256DMany_1000_SHANI);
 
 BENCHMARK(MuHash);
 BENCHMARK(MuHashMul);
@@ -12,6 +12,7 @@
 #include <test/util/setup_common.h>
 #include <uint256.h>
 #include <util/fs.h>
+#include <util/threadpool.h>
 #include <validation.h>
 
 #include <cstdint>
@@ -62,11 +63,13 @@ static void LoadExternalBlockFile(benchmark::Bench& bench)
 
     std::multimap<uint256, FlatFilePos> blocks_with_unknown_parent;
     FlatFilePos pos;
+    ThreadPool pool{"loadblk"};
+    if (const int threads{testing_setup->m_node.chainman->m_options.worker_threads_num}; threads > 0) pool.Start(threads);
     bench.run([&] {
         // "rb" is "binary, O_RDONLY", positioned to the start of the file.
         // The file will be closed by LoadExternalBlockFile().
         AutoFile file{fsbridge::fopen(blkfile, "rb")};
-        testing_setup->m_node.chainman->LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent);
+        testing_setup->m_node.chainman->LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent, &pool);
     });
     fs::remove(blkfile);
 }
@@ -9,10 +9,10 @@
 #include <cstddef>
 #include <vector>
 
-static void ObfuscationBench(benchmark::Bench& bench)
+static void RunObfuscation(benchmark::Bench& bench, size_t size)
 {
     FastRandomContext frc{/*fDeterministic=*/true};
-    auto data{frc.randbytes<std::byte>(1024)};
+    auto data{frc.randbytes<std::byte>(size)};
     const Obfuscation obfuscation{frc.randbytes<Obfuscation::KEY_SIZE>()};
 
     size_t offset{0};
@@ -22,4 +22,9 @@ static void ObfuscationBench(benchmark::Bench& bench)
     });
 }
 
+static void ObfuscationBench(benchmark::Bench& bench) { RunObfuscation(bench, 1024); }
+//! Roughly the size of a block read from disk.
+static void ObfuscationBlockBench(benchmark::Bench& bench) { RunObfuscation(bench, 1'000'000); }
+
 BENCHMARK(ObfuscationBench);
+BENCHMARK(ObfuscationBlockBench);
@@ -5,15 +5,20 @@
 #include <bench/bench.h>
 #include <bench/data/block413567.raw.h>
 #include <flatfile.h>
+#include <dbwrapper.h>
 #include <node/blockstorage.h>
+#include <node/kernel_notifications.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
 #include <serialize.h>
 #include <span.h>
 #include <streams.h>
 #include <test/util/setup_common.h>
+#include <util/check.h>
+#include <util/fs.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <memory>
@@ -62,6 +67,40 @@ static void ReadRawBlockBench(benchmark::Bench& bench)
     });
 }
 
+//! Read a batch of blocks with ReadRawBlocks(), using the given number of block read threads.
+static void ReadRawBlocks(benchmark::Bench& bench, int threads)
+{
+    const auto testing_setup{MakeNoLogFileContext<const TestingSetup>(ChainType::MAIN)};
+    const fs::path blocks_dir{testing_setup->m_args.GetDataDirNet() / "readrawblocks"};
+    fs::create_directories(blocks_dir);
+    const node::BlockManager::Options blockman_opts{
+        .chainparams = testing_setup->m_node.chainman->GetParams(),
+        .block_read_threads = threads,
+        .blocks_dir = blocks_dir,
+        .notifications = *testing_setup->m_node.notifications,
+        .block_tree_db_params = DBParams{
+            .path = blocks_dir / "index",
+            .cache_bytes = 0,
+            .memory_only = true,
+        },
+    };
+    node::BlockManager blockman{*Assert(testing_setup->m_node.shutdown_signal), blockman_opts};
+    const CBlock block{CreateTestBlock()};
+    std::vector<FlatFilePos> positions;
+    for (int i{0}; i < 16; ++i) {
+        positions.push_back(blockman.WriteBlock(block, 413'567));
+    }
+    bench.batch(positions.size()).unit("block").run([&] {
+        const auto results{blockman.ReadRawBlocks(positions)};
+        assert(std::ranges::all_of(results, [](const auto& res) { return res.has_value(); }));
+    });
+}
+
+static void ReadRawBlocksSequentialBench(benchmark::Bench& bench) { ReadRawBlocks(bench, /*threads=*/0); }
+static void ReadRawBlocksParallelBench(benchmark::Bench& bench) { ReadRawBlocks(bench, /*threads=*/4); }
+
 BENCHMARK(WriteBlockBench);
 BENCHMARK(ReadBlockBench);
 BENCHMARK(ReadRawBlockBench);
+BENCHMARK(ReadRawBlocksSequentialBench);
+BENCHMARK(ReadRawBlocksParallelBench);
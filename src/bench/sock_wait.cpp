@@ -0,0 +1,91 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <compat/compat.h>
+#include <util/fs_helpers.h>
+#include <util/sock.h>
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#ifndef WIN32
+#include <sys/socket.h>
+#endif
+
+using namespace std::chrono_literals;
+
+#ifndef WIN32
+
+namespace {
+
+/** Number of simulated peers, each one end of a socket pair. */
+constexpr size_t NUM_PEERS{2000};
+/** Every this many peers, one has received data and is ready. */
+constexpr size_t ACTIVE_PEER_INTERVAL{100};
+
+struct SimulatedPeers {
+    std::vector<std::shared_ptr<Sock>> local;
+    std::vector<std::shared_ptr<Sock>> remote;
+    bool ok{true};
+
+    SimulatedPeers()
+    {
+        RaiseFileDescriptorLimit(2 * NUM_PEERS + 100);
+        for (size_t i{0}; i < NUM_PEERS; ++i) {
+            int s[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, s) != 0) {
+                ok = false;
+                return;
+            }
+            local.push_back(std::make_shared<Sock>(s[0]));
+            remote.push_back(std::make_shared<Sock>(s[1]));
+            if (i % ACTIVE_PEER_INTERVAL == 0) (void)remote.back()->Send("x", 1, 0);
+        }
+    }
+
+    /** Wait for incoming data on all peers, like CConnman::SocketHandler() does for idle peers. */
+    Sock::EventsPerSock Events() const
+    {
+        Sock::EventsPerSock events_per_sock;
+        for (const auto& sock : local) {
+            events_per_sock.emplace(sock, Sock::Events{Sock::RECV});
+        }
+        return events_per_sock;
+    }
+};
+
+} // namespace
+
+static void SockWaitManyPoll(benchmark::Bench& bench)
+{
+    SimulatedPeers peers;
+    assert(peers.ok);
+    bench.run([&] {
+        auto events_per_sock{peers.Events()};
+        const bool ok{events_per_sock.begin()->first->WaitMany(0ms, events_per_sock)};
+        assert(ok);
+    });
+}
+
+static void SockWaitManyEventPoller(benchmark::Bench& bench)
+{
+    SimulatedPeers peers;
+    assert(peers.ok);
+    Sock::EventPoller poller;
+    if (!poller.IsAvailable()) return;
+    bench.run([&] {
+        auto events_per_sock{peers.Events()};
+        const bool ok{poller.WaitMany(0ms, events_per_sock)};
+        assert(ok);
+    });
+}
+
+BENCHMARK(SockWaitManyPoll);
+BENCHMARK(SockWaitManyEventPoller);
+
+#endif // WIN32
@@ -66,7 +66,8 @@ public:
 
     /** Encrypt a packet. Only after Initialize().
      *
-     * It must hold that output.size() == contents.size() + EXPANSION.
+     * It must hold that output.size() == contents.size() + EXPANSION. The contents may be
+     * encrypted in place, if they are output.subspan(LENGTH_LEN + HEADER_LEN, contents.size()).
      */
     void Encrypt(std::span<const std::byte> contents, std::span<const std::byte> aad, bool ignore, std::span<std::byte> output) noexcept;
 
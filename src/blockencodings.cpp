@@ -15,6 +15,9 @@
 #include <txmempool.h>
 #include <validation.h>
 
+#include <algorithm>
+#include <array>
+#include <span>
 #include <unordered_map>
 
 CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block, uint64_t nonce)
@@ -26,10 +29,11 @@ CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block, uint64
     FillShortTxIDSelector();
     // TODO: Use our mempool prior to block acceptance to predictively fill more than just the coinbase
     prefilledtxn[0] = {0, block.vtx[0]};
+    std::vector<const uint256*> wtxids(shorttxids.size());
     for (size_t i = 1; i < block.vtx.size(); i++) {
-        const CTransaction& tx = *block.vtx[i];
-        shorttxids[i - 1] = GetShortID(tx.GetWitnessHash());
+        wtxids[i - 1] = &block.vtx[i]->GetWitnessHash().ToUint256();
     }
+    GetShortIDs(wtxids, shorttxids);
 }
 
 void CBlockHeaderAndShortTxIDs::FillShortTxIDSelector() const
@@ -49,6 +53,30 @@ uint64_t CBlockHeaderAndShortTxIDs::GetShortID(const Wtxid& wtxid) const
     return (*Assert(m_hasher))(wtxid.ToUint256()) & 0xffffffffffffL;
 }
 
+void CBlockHeaderAndShortTxIDs::GetShortIDs(std::span<const uint256* const> wtxids, std::span<uint64_t> out) const
+{
+    static_assert(SHORTTXIDS_LENGTH == 6, "shorttxids calculation assumes 6-byte shorttxids");
+    (*Assert(m_hasher))(wtxids, out);
+    for (uint64_t& id : out) id &= 0xffffffffffffL;
+}
+
+namespace {
+/** Number of short IDs computed together by InitData, so they can be hashed in parallel. */
+constexpr size_t SHORTID_BATCH_SIZE{64};
+
+/** Compute the short IDs of txns[start...], as many as fit in ids. */
+template <typename T>
+void GetShortIDBatch(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::vector<std::pair<Wtxid, T>>& txns, size_t start, std::array<uint64_t, SHORTID_BATCH_SIZE>& ids)
+{
+    std::array<const uint256*, SHORTID_BATCH_SIZE> wtxids;
+    const size_t count{std::min(SHORTID_BATCH_SIZE, txns.size() - start)};
+    for (size_t i = 0; i < count; ++i) {
+        wtxids[i] = &txns[start + i].first.ToUint256();
+    }
+    cmpctblock.GetShortIDs(std::span{wtxids}.first(count), std::span{ids}.first(count));
+}
+} // namespace
+
 /* Reconstructing a compact block is in the hot-path for block relay,
  * so we want to do it as quickly as possible. Because this often
  * involves iterating over the entire mempool, we put all the data we
@@ -116,10 +144,14 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
         return READ_STATUS_FAILED; // Short ID collision
 
     std::vector<bool> have_txn(txn_available.size());
+    std::array<uint64_t, SHORTID_BATCH_SIZE> batch_ids;
     {
     LOCK(pool->cs);
-    for (const auto& [wtxid, txit] : pool->txns_randomized) {
-        uint64_t shortid = cmpctblock.GetShortID(wtxid);
+    const auto& txns_randomized{pool->txns_randomized};
+    for (size_t i = 0; i < txns_randomized.size(); i++) {
+        if (i % SHORTID_BATCH_SIZE == 0) GetShortIDBatch(cmpctblock, txns_randomized, i, batch_ids);
+        const auto& txit{txns_randomized[i].second};
+        uint64_t shortid = batch_ids[i % SHORTID_BATCH_SIZE];
         std::unordered_map<uint64_t, uint16_t>::iterator idit = shorttxids.find(shortid);
         if (idit != shorttxids.end()) {
             if (!have_txn[idit->second]) {
@@ -145,7 +177,8 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
     }
 
     for (size_t i = 0; i < extra_txn.size(); i++) {
-        uint64_t shortid = cmpctblock.GetShortID(extra_txn[i].first);
+        if (i % SHORTID_BATCH_SIZE == 0) GetShortIDBatch(cmpctblock, extra_txn, i, batch_ids);
+        uint64_t shortid = batch_ids[i % SHORTID_BATCH_SIZE];
         std::unordered_map<uint64_t, uint16_t>::iterator idit = shorttxids.find(shortid);
         if (idit != shorttxids.end()) {
             if (!have_txn[idit->second]) {
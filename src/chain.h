@@ -93,6 +93,13 @@ enum BlockStatus : uint32_t {
 class CBlockIndex
 {
 public:
+    // Fields are grouped by how often they are accessed: the ones consulted
+    // when walking and comparing chains (ancestor lookups, work comparison,
+    // difficulty and median time computation) come first, so they share cache
+    // lines, while file positions and the remaining header fields, which are
+    // mostly needed when reading blocks or writing the index to disk, come
+    // last. The order also avoids padding between members.
+
     //! pointer to the hash of the block, if any. Memory is owned by this CBlockIndex
     const uint256* phashBlock{nullptr};
 
@@ -102,32 +109,18 @@ public:
     //! pointer to the index of some further predecessor of this block
     CBlockIndex* pskip{nullptr};
 
-    //! height of the entry in the chain. The genesis block has height 0
-    int nHeight{0};
-
-    //! Which # file this block is stored in (blk?????.dat)
-    int nFile GUARDED_BY(::cs_main){0};
-
-    //! Byte offset within blk?????.dat where this block's data is stored
-    unsigned int nDataPos GUARDED_BY(::cs_main){0};
-
-    //! Byte offset within rev?????.dat where this block's undo data is stored
-    unsigned int nUndoPos GUARDED_BY(::cs_main){0};
-
     //! (memory only) Total amount of work (expected number of hashes) in the chain up to and including this block
     arith_uint256 nChainWork{};
 
-    //! Number of transactions in this block. This will be nonzero if the block
-    //! reached the VALID_TRANSACTIONS level, and zero otherwise.
-    //! Note: in a potential headers-first mode, this number cannot be relied upon
-    unsigned int nTx{0};
-
     //! (memory only) Number of transactions in the chain up to and including this block.
     //! This value will be non-zero if this block and all previous blocks back
     //! to the genesis block or an assumeutxo snapshot block have reached the
     //! VALID_TRANSACTIONS level.
     uint64_t m_chain_tx_count{0};
 
+    //! height of the entry in the chain. The genesis block has height 0
+    int nHeight{0};
+
     //! Verification status of this block. See enum BlockStatus
     //!
     //! Note: this value is modified to show BLOCK_OPT_WITNESS during UTXO snapshot
@@ -136,12 +129,9 @@ public:
     //! @sa ActivateSnapshot
     uint32_t nStatus GUARDED_BY(::cs_main){0};
 
-    //! block header
-    int32_t nVersion{0};
-    uint256 hashMerkleRoot{};
+    //! block header fields used for difficulty and median time computation
     uint32_t nTime{0};
     uint32_t nBits{0};
-    uint32_t nNonce{0};
 
     //! (memory only) Sequential id assigned to distinguish order in which blocks are received.
     //! Initialized to SEQ_ID_INIT_FROM_DISK{1} when loading blocks from disk, except for blocks
@@ -151,11 +141,30 @@ public:
     //! (memory only) Maximum nTime in the chain up to and including this block.
     unsigned int nTimeMax{0};
 
+    //! Number of transactions in this block. This will be nonzero if the block
+    //! reached the VALID_TRANSACTIONS level, and zero otherwise.
+    //! Note: in a potential headers-first mode, this number cannot be relied upon
+    unsigned int nTx{0};
+
+    //! Which # file this block is stored in (blk?????.dat)
+    int nFile GUARDED_BY(::cs_main){0};
+
+    //! Byte offset within blk?????.dat where this block's data is stored
+    unsigned int nDataPos GUARDED_BY(::cs_main){0};
+
+    //! Byte offset within rev?????.dat where this block's undo data is stored
+    unsigned int nUndoPos GUARDED_BY(::cs_main){0};
+
+    //! remaining block header fields
+    int32_t nVersion{0};
+    uint256 hashMerkleRoot{};
+    uint32_t nNonce{0};
+
     explicit CBlockIndex(const CBlockHeader& block)
-        : nVersion{block.nVersion},
-          hashMerkleRoot{block.hashMerkleRoot},
-          nTime{block.nTime},
+        : nTime{block.nTime},
           nBits{block.nBits},
+          nVersion{block.nVersion},
+          hashMerkleRoot{block.hashMerkleRoot},
           nNonce{block.nNonce}
     {
     }
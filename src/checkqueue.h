@@ -11,10 +11,144 @@
 #include <util/threadnames.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iterator>
+#include <memory>
 #include <optional>
+#include <span>
 #include <vector>
 
+/** How a CCheckQueue hands out verifications to its threads. */
+enum class CheckQueueScheduler {
+    //! A single mutex-protected queue that all threads take batches from.
+    SHARED_QUEUE,
+    //! Per-thread lock-free deques; threads that run out of work steal from the others.
+    WORK_STEALING,
+};
+
+/**
+ * Lock-free double-ended queue of ranges of objects, after Chase and Lev
+ * ("Dynamic Circular Work-Stealing Deque", 2005), with the memory orderings of
+ * Lê et al. ("Correct and Efficient Work-Stealing for Weak Memory Models", 2013).
+ *
+ * The owning thread pushes and takes ranges at the bottom, any other thread
+ * may steal the oldest range from the top. Only pointers are stored; the
+ * objects themselves must outlive the deque's use of them.
+ */
+template <typename T>
+class WorkStealingDeque
+{
+private:
+    struct Slot {
+        std::atomic<T*> begin{nullptr};
+        std::atomic<T*> end{nullptr};
+    };
+
+    struct Buffer {
+        //! Number of slots, always a power of two.
+        const int64_t capacity;
+        const std::unique_ptr<Slot[]> slots;
+
+        explicit Buffer(int64_t cap) : capacity{cap}, slots{std::make_unique<Slot[]>(cap)} {}
+
+        void Put(int64_t i, std::span<T> range)
+        {
+            Slot& slot{slots[i & (capacity - 1)]};
+            slot.begin.store(range.data(), std::memory_order_relaxed);
+            slot.end.store(range.data() + range.size(), std::memory_order_relaxed);
+        }
+
+        //! May return a torn range if the slot is concurrently overwritten, in which case the caller's CAS on m_top fails.
+        std::span<T> Get(int64_t i) const
+        {
+            const Slot& slot{slots[i & (capacity - 1)]};
+            T* const begin{slot.begin.load(std::memory_order_relaxed)};
+            T* const end{slot.end.load(std::memory_order_relaxed)};
+            return {begin, end};
+        }
+    };
+
+    static constexpr int64_t INITIAL_CAPACITY{64};
+
+    std::atomic<int64_t> m_top{0};
+    std::atomic<int64_t> m_bottom{0};
+    std::atomic<Buffer*> m_buffer;
+    //! All buffers allocated so far. Outgrown buffers are kept, as a thief may still be reading from them.
+    std::vector<std::unique_ptr<Buffer>> m_buffers;
+
+    Buffer* Grow(Buffer* buffer, int64_t top, int64_t bottom)
+    {
+        Buffer* grown{m_buffers.emplace_back(std::make_unique<Buffer>(buffer->capacity * 2)).get()};
+        for (int64_t i{top}; i < bottom; ++i) grown->Put(i, buffer->Get(i));
+        m_buffer.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+public:
+    WorkStealingDeque()
+    {
+        m_buffer.store(m_buffers.emplace_back(std::make_unique<Buffer>(INITIAL_CAPACITY)).get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    //! Add a range at the bottom. Owner only.
+    void Push(std::span<T> range)
+    {
+        const int64_t bottom{m_bottom.load(std::memory_order_relaxed)};
+        const int64_t top{m_top.load(std::memory_order_acquire)};
+        Buffer* buffer{m_buffer.load(std::memory_order_relaxed)};
+        if (bottom - top >= buffer->capacity) buffer = Grow(buffer, top, bottom);
+        buffer->Put(bottom, range);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    //! Remove the most recently pushed range. Owner only.
+    std::optional<std::span<T>> Take()
+    {
+        const int64_t bottom{m_bottom.load(std::memory_order_relaxed) - 1};
+        Buffer* buffer{m_buffer.load(std::memory_order_relaxed)};
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top{m_top.load(std::memory_order_relaxed)};
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        std::optional<std::span<T>> range{buffer->Get(bottom)};
+        if (top == bottom) {
+            // Last range left, race thieves for it.
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                range.reset();
+            }
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return range;
+    }
+
+    //! Remove the oldest range. Any thread. Returns nullopt if empty or if another thread won the race for it.
+    std::optional<std::span<T>> Steal()
+    {
+        int64_t top{m_top.load(std::memory_order_acquire)};
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom{m_bottom.load(std::memory_order_acquire)};
+        if (top >= bottom) return std::nullopt;
+        const std::span<T> range{m_buffer.load(std::memory_order_acquire)->Get(top)};
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return range;
+    }
+
+    bool Empty() const
+    {
+        return m_bottom.load(std::memory_order_seq_cst) <= m_top.load(std::memory_order_seq_cst);
+    }
+};
+
 /**
  * Queue for verifications that have to be performed.
   * The verifications are represented by a type T, which must provide an
@@ -28,6 +162,13 @@
   * the master is done adding work, it temporarily joins the worker pool
   * as an N'th worker, until all jobs are done.
   *
+  * With CheckQueueScheduler::WORK_STEALING, every thread owns a
+  * WorkStealingDeque of ranges of verifications instead. The master pushes
+  * each added batch onto its own deque, and threads that run out of work
+  * steal ranges from the others, splitting large ranges so that the
+  * remainder can be stolen in turn. The mutex is then only taken to sleep,
+  * to wake sleeping threads and to record a failed verification.
+  *
   */
 template <typename T, typename R = std::remove_cvref_t<decltype(std::declval<T>()().value())>>
 class CCheckQueue
@@ -68,6 +209,21 @@ private:
     std::vector<std::thread> m_worker_threads;
     bool m_request_stop GUARDED_BY(m_mutex){false};
 
+    const CheckQueueScheduler m_scheduler;
+
+    //! Work stealing: one deque per thread, the master's first.
+    std::vector<std::unique_ptr<WorkStealingDeque<T>>> m_deques;
+    //! Work stealing: the batches added by the master, kept alive until Complete() returns.
+    std::vector<std::vector<T>> m_batches;
+    //! Work stealing: number of verifications that haven't completed yet.
+    std::atomic<size_t> m_todo{0};
+    //! Work stealing: number of threads sleeping or about to sleep on m_worker_cv.
+    std::atomic<int> m_sleeping{0};
+    //! Work stealing: whether m_result has a value, to skip the remaining verifications.
+    std::atomic<bool> m_failed{false};
+    //! Work stealing: ranges larger than this are split before being processed.
+    const size_t m_split_size;
+
     /** Internal function that does bulk of the verification work. If fMaster, return the final result. */
     std::optional<R> Loop(bool fMaster) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
@@ -136,20 +292,114 @@ private:
         } while (true);
     }
 
+    /** Wake a sleeping thread, if any, after making a range available. */
+    void NotifySleeping() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        // Pairs with the increment of m_sleeping before the sleeping thread checks the deques.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sleeping.load(std::memory_order_relaxed) > 0) {
+            LOCK(m_mutex);
+            m_worker_cv.notify_one();
+        }
+    }
+
+    bool AnyStealable() const
+    {
+        return std::ranges::any_of(m_deques, [](const auto& deque) { return !deque->Empty(); });
+    }
+
+    std::optional<std::span<T>> TakeOrSteal(size_t own)
+    {
+        if (auto range{m_deques[own]->Take()}) return range;
+        for (size_t i{1}; i < m_deques.size(); ++i) {
+            if (auto range{m_deques[(own + i) % m_deques.size()]->Steal()}) return range;
+        }
+        return std::nullopt;
+    }
+
+    /** Work stealing counterpart of Loop(), for the thread owning deque `own`. */
+    std::optional<R> LoopWorkStealing(size_t own, bool fMaster) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        while (true) {
+            while (auto range{TakeOrSteal(own)}) {
+                // Leave the upper halves of a large range for others to steal.
+                while (range->size() > m_split_size) {
+                    const size_t half{range->size() / 2};
+                    m_deques[own]->Push(range->subspan(half));
+                    NotifySleeping();
+                    range = range->first(half);
+                }
+                if (!m_failed.load(std::memory_order_relaxed)) {
+                    for (T& check : *range) {
+                        if (auto result{check()}) {
+                            LOCK(m_mutex);
+                            if (!m_result.has_value()) m_result = std::move(result);
+                            m_failed.store(true, std::memory_order_relaxed);
+                            break;
+                        }
+                    }
+                }
+                if (m_todo.fetch_sub(range->size(), std::memory_order_acq_rel) == range->size()) {
+                    // We processed the last verifications; inform the master it can return the result
+                    LOCK(m_mutex);
+                    m_worker_cv.notify_all();
+                }
+            }
+
+            bool done{false};
+            m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+            {
+                WAIT_LOCK(m_mutex, lock);
+                while (!m_request_stop && !AnyStealable()) {
+                    if (fMaster && m_todo.load(std::memory_order_acquire) == 0) {
+                        done = true;
+                        break;
+                    }
+                    m_worker_cv.wait(lock);
+                }
+                if (m_request_stop) {
+                    // return value does not matter, because m_request_stop is only set in the destructor.
+                    return std::nullopt;
+                }
+            }
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            if (done) {
+                // All verifications are done, so no other thread accesses the batches anymore.
+                m_batches.clear();
+                LOCK(m_mutex);
+                std::optional<R> to_return = std::move(m_result);
+                // reset the status for new work later
+                m_result = std::nullopt;
+                m_failed.store(false, std::memory_order_relaxed);
+                return to_return;
+            }
+        }
+    }
+
 public:
     //! Mutex to ensure only one concurrent CCheckQueueControl
     Mutex m_control_mutex;
 
     //! Create a new check queue
-    explicit CCheckQueue(unsigned int batch_size, int worker_threads_num)
-        : nBatchSize(batch_size)
+    explicit CCheckQueue(unsigned int batch_size, int worker_threads_num, CheckQueueScheduler scheduler = CheckQueueScheduler::SHARED_QUEUE)
+        : nBatchSize(batch_size), m_scheduler{scheduler}, m_split_size{std::max(1U, batch_size / 16)}
     {
-        LogInfo("Script verification uses %d additional threads", worker_threads_num);
+        LogInfo("Script verification uses %d additional threads%s", worker_threads_num,
+                m_scheduler == CheckQueueScheduler::WORK_STEALING ? " with work stealing" : "");
+        if (m_scheduler == CheckQueueScheduler::WORK_STEALING) {
+            for (int n = 0; n <= worker_threads_num; ++n) {
+                m_deques.emplace_back(std::make_unique<WorkStealingDeque<T>>());
+            }
+        }
         m_worker_threads.reserve(worker_threads_num);
         for (int n = 0; n < worker_threads_num; ++n) {
             m_worker_threads.emplace_back([this, n]() {
                 util::ThreadRename(strprintf("scriptch.%i", n));
-                Loop(false /* worker thread */);
+                if (m_scheduler == CheckQueueScheduler::WORK_STEALING) {
+                    LoopWorkStealing(n + 1, false /* worker thread */);
+                } else {
+                    Loop(false /* worker thread */);
+                }
             });
         }
     }
@@ -165,6 +415,9 @@ public:
     //! its error.
     std::optional<R> Complete() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
+        if (m_scheduler == CheckQueueScheduler::WORK_STEALING) {
+            return LoopWorkStealing(0, true /* master thread */);
+        }
         return Loop(true /* master thread */);
     }
 
@@ -175,6 +428,13 @@ public:
             return;
         }
 
+        if (m_scheduler == CheckQueueScheduler::WORK_STEALING) {
+            m_todo.fetch_add(vChecks.size(), std::memory_order_relaxed);
+            m_deques[0]->Push(m_batches.emplace_back(std::move(vChecks)));
+            NotifySleeping();
+            return;
+        }
+
         {
             LOCK(m_mutex);
             queue.insert(queue.end(), std::make_move_iterator(vChecks.begin()), std::make_move_iterator(vChecks.end()));
@@ -198,6 +458,8 @@ public:
     }
 
     bool HasThreads() const { return !m_worker_threads.empty(); }
+
+    CheckQueueScheduler GetScheduler() const { return m_scheduler; }
 };
 
 /**
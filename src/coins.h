@@ -215,6 +215,10 @@ public:
  * so nodes can be connected in a linked list, and in some cases the hash value is stored as well.
  * Using an additional sizeof(void*)*4 for MAX_BLOCK_SIZE_BYTES should thus be sufficient so that
  * all implementations can allocate the nodes from the PoolAllocator.
+ *
+ * The map must be node-based. The flagged-entry linked list through CCoinsCacheEntry,
+ * CoinsViewCacheCursor and BatchWrite() all rely on entries keeping their address when
+ * the map rehashes, which an open-addressing table does not guarantee.
  */
 using CCoinsMap = std::unordered_map<COutPoint,
                                      CCoinsCacheEntry,
@@ -420,6 +424,13 @@ public:
      */
     bool HaveCoinInCache(const COutPoint &outpoint) const;
 
+    /**
+     * Check if the cache has an entry for the given outpoint, including one
+     * for a coin that was spent but not flushed yet. No calls to the backing
+     * CCoinsView are made.
+     */
+    bool HaveEntryInCache(const COutPoint& outpoint) const;
+
     /**
      * Return a reference to Coin in the cache, or coinEmpty if not found. This is
      * more efficient than GetCoin.
@@ -447,6 +458,19 @@ public:
      */
     void EmplaceCoinInternalDANGER(COutPoint&& outpoint, Coin&& coin);
 
+    /**
+     * Insert a coin that was read from the base view into the cache, without
+     * marking it DIRTY or FRESH, as if it had been fetched on a cache miss.
+     * Has no effect if the outpoint is already present in the cache.
+     *
+     * The caller must guarantee that the coin reflects the current state of
+     * the base view. Used to warm the cache with block inputs ahead of ConnectBlock.
+     * @sa InputFetcher
+     *
+     * @returns whether the coin was inserted.
+     */
+    bool PrefetchCoin(const COutPoint& outpoint, Coin&& coin);
+
     /**
      * Spend a coin. Pass moveto in order to get the deleted data.
      * If no unspent output exists for the passed outpoint, this call
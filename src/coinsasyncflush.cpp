@@ -0,0 +1,182 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <coinsasyncflush.h>
+
+#include <logging/timer.h>
+#include <tinyformat.h>
+#include <util/check.h>
+#include <util/log.h>
+#include <util/threadnames.h>
+
+#include <utility>
+
+/**
+ * Flushed coins frozen until they are written to the base view.
+ *
+ * Populated once by BatchWrite() from the flushing cache, and never modified
+ * afterwards. WriteToBase() hands the entries to the base view through an
+ * erasing cursor, which the base only reads from: the map and the flagged
+ * entry list are left untouched, so concurrent lookups remain safe.
+ */
+class CoinsViewAsyncFlush::Generation final : public CCoinsViewCache
+{
+public:
+    using CCoinsViewCache::CCoinsViewCache;
+
+    std::optional<std::optional<Coin>> Find(const COutPoint& outpoint) const
+    {
+        const auto it{cacheCoins.find(outpoint)};
+        if (it == cacheCoins.end()) return std::nullopt;
+        if (it->second.coin.IsSpent()) return std::optional<Coin>{};
+        return std::optional{it->second.coin};
+    }
+
+    void WriteToBase()
+    {
+        // The cursor decrements its own copy of the dirty count, the entries are not changed.
+        size_t dirty_count{m_dirty_count};
+        CoinsViewCacheCursor cursor{dirty_count, m_sentinel, cacheCoins, /*will_erase=*/true};
+        base->BatchWrite(cursor, hashBlock);
+    }
+};
+
+CoinsViewAsyncFlush::CoinsViewAsyncFlush(CCoinsView* base, bool enabled)
+    : CCoinsViewBacked(base), m_enabled{enabled}
+{
+    if (m_enabled) {
+        m_writer = std::thread{[this]() {
+            util::ThreadRename("coinsflush");
+            ThreadWriter();
+        }};
+    }
+}
+
+CoinsViewAsyncFlush::~CoinsViewAsyncFlush()
+{
+    if (!m_writer.joinable()) return;
+    {
+        WAIT_LOCK(m_mutex, lock);
+        // Let the writer finish the in-flight generation, so no flushed coins are lost.
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return !m_in_flight || m_error; });
+        m_request_stop = true;
+    }
+    m_cv.notify_all();
+    m_writer.join();
+}
+
+void CoinsViewAsyncFlush::ThreadWriter()
+{
+    WAIT_LOCK(m_mutex, lock);
+    while (true) {
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_request_stop || (m_in_flight && !m_writing && !m_error); });
+        if (m_request_stop) return;
+        m_writing = true;
+        Generation& generation{*m_in_flight};
+        std::exception_ptr error;
+        {
+            REVERSE_LOCK(lock, m_mutex);
+            try {
+                LOG_TIME_MILLIS_WITH_CATEGORY(strprintf("background write of %u coins", generation.GetDirtyCount()), BCLog::COINDB);
+                generation.WriteToBase();
+            } catch (const std::exception& e) {
+                LogError("Background write of the coins cache failed: %s", e.what());
+                error = std::current_exception();
+            }
+        }
+        m_writing = false;
+        if (error) {
+            // Keep serving reads from the generation, its coins never reached the base view.
+            m_error = error;
+        } else {
+            m_in_flight.reset();
+        }
+        m_cv.notify_all();
+    }
+}
+
+void CoinsViewAsyncFlush::WaitForFlushLocked(UniqueLock<Mutex>& lock) const
+{
+    m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return !m_in_flight || m_error; });
+    if (m_error) std::rethrow_exception(m_error);
+}
+
+void CoinsViewAsyncFlush::WaitForFlush() const
+{
+    WAIT_LOCK(m_mutex, lock);
+    WaitForFlushLocked(lock);
+}
+
+bool CoinsViewAsyncFlush::IsFlushing() const
+{
+    return WITH_LOCK(m_mutex, return m_in_flight != nullptr);
+}
+
+size_t CoinsViewAsyncFlush::DynamicMemoryUsage() const
+{
+    LOCK(m_mutex);
+    return m_in_flight ? m_in_flight->DynamicMemoryUsage() : 0;
+}
+
+std::optional<std::optional<Coin>> CoinsViewAsyncFlush::FindInFlight(const COutPoint& outpoint) const
+{
+    if (!m_enabled) return std::nullopt;
+    LOCK(m_mutex);
+    if (!m_in_flight) return std::nullopt;
+    return m_in_flight->Find(outpoint);
+}
+
+std::optional<Coin> CoinsViewAsyncFlush::GetCoin(const COutPoint& outpoint) const
+{
+    if (auto coin{FindInFlight(outpoint)}) return *coin;
+    return base->GetCoin(outpoint);
+}
+
+std::optional<Coin> CoinsViewAsyncFlush::PeekCoin(const COutPoint& outpoint) const
+{
+    if (auto coin{FindInFlight(outpoint)}) return *coin;
+    return base->PeekCoin(outpoint);
+}
+
+bool CoinsViewAsyncFlush::HaveCoin(const COutPoint& outpoint) const
+{
+    if (auto coin{FindInFlight(outpoint)}) return coin->has_value();
+    return base->HaveCoin(outpoint);
+}
+
+uint256 CoinsViewAsyncFlush::GetBestBlock() const
+{
+    if (m_enabled) {
+        LOCK(m_mutex);
+        if (m_in_flight) return m_in_flight->GetBestBlock();
+    }
+    return base->GetBestBlock();
+}
+
+void CoinsViewAsyncFlush::BatchWrite(CoinsViewCacheCursor& cursor, const uint256& hashBlock)
+{
+    if (!m_enabled) return base->BatchWrite(cursor, hashBlock);
+
+    {
+        WAIT_LOCK(m_mutex, lock);
+        if (m_in_flight) {
+            LOG_TIME_MILLIS_WITH_CATEGORY("wait for previous background write of the coins cache", BCLog::BENCH);
+            WaitForFlushLocked(lock);
+        } else if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+    }
+    // Nothing is in flight, so the base view alone represents the state the
+    // flushing cache was built on, and FRESH flags stay valid against it.
+    auto generation{std::make_unique<Generation>(base)};
+    generation->BatchWrite(cursor, hashBlock);
+    WITH_LOCK(m_mutex, m_in_flight = std::move(generation));
+    m_cv.notify_all();
+}
+
+std::unique_ptr<CCoinsViewCursor> CoinsViewAsyncFlush::Cursor() const
+{
+    if (m_enabled) WaitForFlush();
+    return base->Cursor();
+}
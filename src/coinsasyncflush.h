@@ -0,0 +1,93 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_COINSASYNCFLUSH_H
+#define BITCOIN_COINSASYNCFLUSH_H
+
+#include <coins.h>
+#include <sync.h>
+#include <uint256.h>
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/**
+ * CCoinsView layer that writes flushed coins to its base on a background thread.
+ *
+ * Sits between the in-memory coins cache and the database. When enabled,
+ * BatchWrite() does not write through to the database but freezes the
+ * flushed entries into an immutable generation (a CCoinsViewCache that is
+ * never modified again) and hands it to a writer thread. Reads are answered
+ * from the in-flight generation first and fall back to the base view, so the
+ * caller sees the state as of the last flush while the database catches up.
+ *
+ * At most one generation is in flight: a BatchWrite() while the previous
+ * generation is still being written blocks until that write completes. The
+ * database is written with the usual head-blocks protocol of
+ * CCoinsViewDB::BatchWrite, so a crash during a background write leaves the
+ * database in a state that ReplayBlocks() can recover from.
+ *
+ * Callers that need the database itself to be up to date (pruning, cursors
+ * over the database, shutdown) must call WaitForFlush() first. Errors raised
+ * by a background write are rethrown by the next BatchWrite() or
+ * WaitForFlush().
+ *
+ * Reads are safe to call concurrently with each other. BatchWrite() and
+ * WaitForFlush() must not be called concurrently with each other.
+ */
+class CoinsViewAsyncFlush final : public CCoinsViewBacked
+{
+private:
+    class Generation;
+
+    const bool m_enabled;
+
+    mutable Mutex m_mutex;
+    mutable std::condition_variable m_cv;
+    //! Generation currently being written to the base view, if any.
+    std::unique_ptr<Generation> m_in_flight GUARDED_BY(m_mutex);
+    //! Whether the writer thread has picked up m_in_flight.
+    bool m_writing GUARDED_BY(m_mutex){false};
+    //! Exception raised by the last background write, to be rethrown to the caller.
+    std::exception_ptr m_error GUARDED_BY(m_mutex);
+    bool m_request_stop GUARDED_BY(m_mutex){false};
+    std::thread m_writer;
+
+    void ThreadWriter() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void WaitForFlushLocked(UniqueLock<Mutex>& lock) const EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+    /** Look up an outpoint in the in-flight generation. Returns nullopt if it has no entry for it. */
+    std::optional<std::optional<Coin>> FindInFlight(const COutPoint& outpoint) const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+public:
+    //! If `enabled` is false, BatchWrite() writes through to `base` synchronously.
+    CoinsViewAsyncFlush(CCoinsView* base, bool enabled);
+    ~CoinsViewAsyncFlush() override;
+
+    CoinsViewAsyncFlush(const CoinsViewAsyncFlush&) = delete;
+    CoinsViewAsyncFlush& operator=(const CoinsViewAsyncFlush&) = delete;
+
+    std::optional<Coin> GetCoin(const COutPoint& outpoint) const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    std::optional<Coin> PeekCoin(const COutPoint& outpoint) const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    bool HaveCoin(const COutPoint& outpoint) const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    uint256 GetBestBlock() const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void BatchWrite(CoinsViewCacheCursor& cursor, const uint256& hashBlock) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    std::unique_ptr<CCoinsViewCursor> Cursor() const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    bool IsEnabled() const { return m_enabled; }
+
+    //! Whether a generation is still waiting to be fully written to the base view.
+    bool IsFlushing() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    //! Memory held by the in-flight generation, if any.
+    size_t DynamicMemoryUsage() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /** Block until the in-flight generation, if any, has been written to the base view. */
+    void WaitForFlush() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+};
+
+#endif // BITCOIN_COINSASYNCFLUSH_H
@@ -22,5 +22,35 @@ void static inline GetCPUID(uint32_t leaf, uint32_t subleaf, uint32_t& a, uint32
 #endif
 }
 
+/** Whether the OS saves and restores all register state components in mask (see XCR0).
+ *  Only call this if CPUID reports OSXSAVE support. */
+bool static inline XCR0Enabled(uint32_t mask)
+{
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return (a & mask) == mask;
+}
+
+/** Whether AVX2 instructions can be used (CPU support and OS-enabled YMM state). */
+bool static inline HaveAVX2()
+{
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    const bool have_xsave = (ecx >> 27) & 1;
+    const bool have_avx = (ecx >> 28) & 1;
+    if (!have_xsave || !have_avx || !XCR0Enabled(0x6)) return false;
+    GetCPUID(7, 0, eax, ebx, ecx, edx);
+    return (ebx >> 5) & 1;
+}
+
+/** Whether AVX-512 Foundation instructions can be used (CPU support and OS-enabled ZMM state). */
+bool static inline HaveAVX512F()
+{
+    if (!HaveAVX2()) return false;
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(7, 0, eax, ebx, ecx, edx);
+    return ((ebx >> 16) & 1) && XCR0Enabled(0xe6);
+}
+
 #endif // defined(__x86_64__) || defined(__amd64__) || defined(__i386__)
 #endif // BITCOIN_COMPAT_CPUID_H
@@ -5,6 +5,7 @@
 // Based on the public domain implementation 'merged' by D. J. Bernstein
 // See https://cr.yp.to/chacha.html.
 
+#include <compat/cpuid.h> // IWYU pragma: keep
 #include <crypto/common.h>
 #include <crypto/chacha20.h>
 #include <support/cleanse.h>
@@ -13,6 +14,71 @@
 #include <bit>
 #include <cassert>
 
+// SSE2 and NEON are part of the baseline instruction set of the targets that have them, so the
+// 4-way implementation needs no runtime detection and is compiled directly into this file.
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+#define ENABLE_CHACHA20_4WAY
+#include <crypto/chacha20_vec.ipp>
+#endif
+
+#if defined(ENABLE_AVX2)
+namespace chacha20_avx2 {
+size_t Crypt_8way(uint32_t input[12], const std::byte* in, std::byte* out, size_t blocks) noexcept;
+}
+#endif
+
+#if defined(ENABLE_AVX512)
+namespace chacha20_avx512 {
+size_t Crypt_16way(uint32_t input[12], const std::byte* in, std::byte* out, size_t blocks) noexcept;
+}
+#endif
+
+namespace {
+
+using MultiBlockFn = size_t (*)(uint32_t input[12], const std::byte* in, std::byte* out, size_t blocks) noexcept;
+
+/** Multi-block implementations usable on this CPU, widest first (nullptr if unavailable). */
+struct MultiBlockImpls
+{
+    MultiBlockFn way16{nullptr};
+    MultiBlockFn way8{nullptr};
+    MultiBlockFn way4{nullptr};
+};
+
+MultiBlockImpls DetectMultiBlockImpls()
+{
+    MultiBlockImpls ret;
+#if defined(ENABLE_CHACHA20_4WAY)
+    ret.way4 = ChaCha20MultiBlock<vec32x4>;
+#endif
+
+#if defined(HAVE_GETCPUID)
+#if defined(ENABLE_AVX2)
+    if (HaveAVX2()) ret.way8 = chacha20_avx2::Crypt_8way;
+#endif
+#if defined(ENABLE_AVX512)
+    if (HaveAVX512F()) ret.way16 = chacha20_avx512::Crypt_16way;
+#endif
+#endif // defined(HAVE_GETCPUID)
+
+    return ret;
+}
+
+/** Process as many leading blocks as possible with the multi-block implementations, advancing
+ *  the block counter in input. Returns the number of blocks processed. */
+size_t CryptMultiBlock(uint32_t input[12], const std::byte* in, std::byte* out, size_t blocks) noexcept
+{
+    static const MultiBlockImpls impls{DetectMultiBlockImpls()};
+    size_t done{0};
+    for (const MultiBlockFn fn : {impls.way16, impls.way8, impls.way4}) {
+        if (fn == nullptr) continue;
+        done += fn(input, in ? in + done * ChaCha20Aligned::BLOCKLEN : nullptr, out + done * ChaCha20Aligned::BLOCKLEN, blocks - done);
+    }
+    return done;
+}
+
+} // namespace
+
 #define QUARTERROUND(a,b,c,d) \
   a += b; d = std::rotl(d ^ a, 16); \
   c += d; b = std::rotl(b ^ c, 12); \
@@ -62,6 +128,10 @@ inline void ChaCha20Aligned::Keystream(std::span<std::byte> output) noexcept
     size_t blocks = output.size() / BLOCKLEN;
     assert(blocks * BLOCKLEN == output.size());
 
+    const size_t multi_blocks{CryptMultiBlock(input, nullptr, c, blocks)};
+    c += multi_blocks * BLOCKLEN;
+    blocks -= multi_blocks;
+
     uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
     uint32_t j4, j5, j6, j7, j8, j9, j10, j11, j12, j13, j14, j15;
 
@@ -165,6 +235,11 @@ inline void ChaCha20Aligned::Crypt(std::span<const std::byte> in_bytes, std::spa
     size_t blocks = out_bytes.size() / BLOCKLEN;
     assert(blocks * BLOCKLEN == out_bytes.size());
 
+    const size_t multi_blocks{CryptMultiBlock(input, m, c, blocks)};
+    m += multi_blocks * BLOCKLEN;
+    c += multi_blocks * BLOCKLEN;
+    blocks -= multi_blocks;
+
     uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
     uint32_t j4, j5, j6, j7, j8, j9, j10, j11, j12, j13, j14, j15;
 
@@ -0,0 +1,19 @@
+// Copyright (c) 2025-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <crypto/chacha20_vec.ipp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chacha20_avx2 {
+size_t Crypt_8way(uint32_t input[12], const std::byte* in, std::byte* out, size_t blocks) noexcept
+{
+    return ChaCha20MultiBlock<vec32x8>(input, in, out, blocks);
+}
+} // namespace chacha20_avx2
+
+#endif
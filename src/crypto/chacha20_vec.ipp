@@ -0,0 +1,108 @@
+// Copyright (c) 2025-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Multi-block ChaCha20 using GCC/Clang vector extensions. Each vector lane
+// holds the state of a separate block, so the round function is the scalar
+// one applied to LANES consecutive blocks at once. This file is included by
+// translation units compiled with different target flags (see
+// chacha20_avx2.cpp and chacha20_avx512.cpp), so everything in it has
+// internal linkage.
+
+#include <crypto/common.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+typedef uint32_t vec32x4 __attribute__((vector_size(16)));
+typedef uint32_t vec32x8 __attribute__((vector_size(32)));
+typedef uint32_t vec32x16 __attribute__((vector_size(64)));
+
+template <int BITS, typename Vec>
+inline Vec RotL(Vec x) { return (x << BITS) | (x >> (32 - BITS)); }
+
+template <typename Vec>
+inline void QuarterRound(Vec& a, Vec& b, Vec& c, Vec& d)
+{
+    a += b; d = RotL<16>(d ^ a);
+    c += d; b = RotL<12>(b ^ c);
+    a += b; d = RotL<8>(d ^ a);
+    c += d; b = RotL<7>(b ^ c);
+}
+
+/** Encrypt (or, if in is nullptr, output the keystream for) as many groups of
+ *  one block per lane of vec as fit in blocks, advancing the block counter in
+ *  input[8..9] accordingly. Returns the number of blocks processed. in and out
+ *  may alias. */
+template <typename vec>
+size_t ChaCha20MultiBlock(uint32_t input[12], const std::byte* in, std::byte* out, size_t blocks) noexcept
+{
+    static constexpr size_t LANES{sizeof(vec) / sizeof(uint32_t)};
+    static constexpr size_t BLOCKLEN{64};
+
+    vec lane_offset;
+    for (size_t i = 0; i < LANES; ++i) lane_offset[i] = i;
+
+    size_t done{0};
+    for (; blocks - done >= LANES; done += LANES) {
+        // Per-lane block counters, carrying into the first nonce word like the scalar code
+        // (a true vector comparison yields all ones, so subtracting it adds one).
+        const vec j12 = input[8] + lane_offset;
+        const vec j13 = input[9] - (vec)(j12 < input[8]);
+
+        vec x[16];
+        x[0] = vec{} + 0x61707865;
+        x[1] = vec{} + 0x3320646e;
+        x[2] = vec{} + 0x79622d32;
+        x[3] = vec{} + 0x6b206574;
+        for (int i = 0; i < 8; ++i) x[4 + i] = vec{} + input[i];
+        x[12] = j12;
+        x[13] = j13;
+        x[14] = vec{} + input[10];
+        x[15] = vec{} + input[11];
+
+        for (int round = 0; round < 10; ++round) {
+            QuarterRound(x[0], x[4], x[8], x[12]);
+            QuarterRound(x[1], x[5], x[9], x[13]);
+            QuarterRound(x[2], x[6], x[10], x[14]);
+            QuarterRound(x[3], x[7], x[11], x[15]);
+            QuarterRound(x[0], x[5], x[10], x[15]);
+            QuarterRound(x[1], x[6], x[11], x[12]);
+            QuarterRound(x[2], x[7], x[8], x[13]);
+            QuarterRound(x[3], x[4], x[9], x[14]);
+        }
+
+        x[0] += 0x61707865;
+        x[1] += 0x3320646e;
+        x[2] += 0x79622d32;
+        x[3] += 0x6b206574;
+        for (int i = 0; i < 8; ++i) x[4 + i] += input[i];
+        x[12] += j12;
+        x[13] += j13;
+        x[14] += input[10];
+        x[15] += input[11];
+
+        // Transpose from word-major (one vector per state word) to block-major output.
+        uint32_t words[16][LANES];
+        std::memcpy(words, x, sizeof(words));
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            std::byte* c = out + (done + lane) * BLOCKLEN;
+            if (in) {
+                const std::byte* m = in + (done + lane) * BLOCKLEN;
+                for (int i = 0; i < 16; ++i) WriteLE32(c + 4 * i, words[i][lane] ^ ReadLE32(m + 4 * i));
+            } else {
+                for (int i = 0; i < 16; ++i) WriteLE32(c + 4 * i, words[i][lane]);
+            }
+        }
+
+        const uint32_t counter{input[8]};
+        input[8] += LANES;
+        if (input[8] < counter) ++input[9];
+    }
+    return done;
+}
+
+} // namespace
@@ -2,9 +2,16 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <compat/cpuid.h> // IWYU pragma: keep
 #include <crypto/common.h>
 #include <crypto/poly1305.h>
 
+#if defined(ENABLE_AVX2)
+namespace poly1305_avx2 {
+size_t Blocks_4way(uint32_t h[5], const uint32_t r[5], const unsigned char* m, size_t bytes) noexcept;
+}
+#endif
+
 namespace poly1305_donna {
 
 // Based on the public domain implementation by Andrew Moon
@@ -36,6 +43,15 @@ void poly1305_init(poly1305_context *st, const unsigned char key[32]) noexcept {
 }
 
 static void poly1305_blocks(poly1305_context *st, const unsigned char *m, size_t bytes) noexcept {
+#if defined(ENABLE_AVX2) && defined(HAVE_GETCPUID)
+    static const bool use_avx2 = HaveAVX2();
+    if (use_avx2 && !st->final) {
+        const size_t done = poly1305_avx2::Blocks_4way(st->h, st->r, m, bytes);
+        m += done;
+        bytes -= done;
+    }
+#endif
+
     const uint32_t hibit = (st->final) ? 0 : (1UL << 24); /* 1 << 128 */
     uint32_t r0,r1,r2,r3,r4;
     uint32_t s1,s2,s3,s4;
@@ -0,0 +1,132 @@
+// Copyright (c) 2025-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+#include <crypto/common.h>
+
+namespace poly1305_avx2 {
+namespace {
+
+// Four interleaved accumulators, one per 64-bit lane, each absorbing every fourth 16-byte block
+// and multiplied by r^4 per step. At the end lane k is multiplied by r^(4-k) and the lanes are
+// summed, which yields the same result as block-by-block evaluation. Limbs are 26 bits wide as
+// in the scalar poly1305-donna-32 code, so _mm256_mul_epu32 computes all products.
+
+__m256i inline K(uint64_t x) { return _mm256_set1_epi64x(x); }
+__m256i inline Add(__m256i x, __m256i y) { return _mm256_add_epi64(x, y); }
+__m256i inline Mul(__m256i x, __m256i y) { return _mm256_mul_epu32(x, y); }
+__m256i inline And(__m256i x, __m256i y) { return _mm256_and_si256(x, y); }
+__m256i inline ShR(__m256i x, int n) { return _mm256_srli_epi64(x, n); }
+__m256i inline ShL(__m256i x, int n) { return _mm256_slli_epi64(x, n); }
+
+/** out = a * b (partially reduced mod 2^130 - 5). */
+void MulScalar(uint32_t out[5], const uint32_t a[5], const uint32_t b[5])
+{
+    const uint32_t s1 = b[1] * 5, s2 = b[2] * 5, s3 = b[3] * 5, s4 = b[4] * 5;
+    uint64_t d0 = ((uint64_t)a[0] * b[0]) + ((uint64_t)a[1] * s4) + ((uint64_t)a[2] * s3) + ((uint64_t)a[3] * s2) + ((uint64_t)a[4] * s1);
+    uint64_t d1 = ((uint64_t)a[0] * b[1]) + ((uint64_t)a[1] * b[0]) + ((uint64_t)a[2] * s4) + ((uint64_t)a[3] * s3) + ((uint64_t)a[4] * s2);
+    uint64_t d2 = ((uint64_t)a[0] * b[2]) + ((uint64_t)a[1] * b[1]) + ((uint64_t)a[2] * b[0]) + ((uint64_t)a[3] * s4) + ((uint64_t)a[4] * s3);
+    uint64_t d3 = ((uint64_t)a[0] * b[3]) + ((uint64_t)a[1] * b[2]) + ((uint64_t)a[2] * b[1]) + ((uint64_t)a[3] * b[0]) + ((uint64_t)a[4] * s4);
+    uint64_t d4 = ((uint64_t)a[0] * b[4]) + ((uint64_t)a[1] * b[3]) + ((uint64_t)a[2] * b[2]) + ((uint64_t)a[3] * b[1]) + ((uint64_t)a[4] * b[0]);
+    uint64_t c;
+                  c = d0 >> 26; out[0] = (uint32_t)d0 & 0x3ffffff;
+    d1 += c;      c = d1 >> 26; out[1] = (uint32_t)d1 & 0x3ffffff;
+    d2 += c;      c = d2 >> 26; out[2] = (uint32_t)d2 & 0x3ffffff;
+    d3 += c;      c = d3 >> 26; out[3] = (uint32_t)d3 & 0x3ffffff;
+    d4 += c;      c = d4 >> 26; out[4] = (uint32_t)d4 & 0x3ffffff;
+    c = out[0] + c * 5;         out[0] = (uint32_t)c & 0x3ffffff;
+    out[1] += (uint32_t)(c >> 26);
+}
+
+/** Load limb i of four consecutive blocks into the four lanes. */
+__m256i inline Load4(const unsigned char* m, int i, uint32_t hibit)
+{
+    const auto limb = [&](const unsigned char* b) -> uint64_t {
+        if (i == 4) return (ReadLE32(b + 12) >> 8) | hibit;
+        return (ReadLE32(b + 3 * i) >> (2 * i)) & 0x3ffffff;
+    };
+    return _mm256_set_epi64x(limb(m + 48), limb(m + 32), limb(m + 16), limb(m));
+}
+
+/** d[j] = sum of h[i] * r[j-i] with the wrapped-around terms multiplied by 5 (s = 5 * r). */
+void inline MulVec(__m256i d[5], const __m256i h[5], const __m256i r[5], const __m256i s[5])
+{
+    d[0] = Add(Add(Add(Mul(h[0], r[0]), Mul(h[1], s[4])), Add(Mul(h[2], s[3]), Mul(h[3], s[2]))), Mul(h[4], s[1]));
+    d[1] = Add(Add(Add(Mul(h[0], r[1]), Mul(h[1], r[0])), Add(Mul(h[2], s[4]), Mul(h[3], s[3]))), Mul(h[4], s[2]));
+    d[2] = Add(Add(Add(Mul(h[0], r[2]), Mul(h[1], r[1])), Add(Mul(h[2], r[0]), Mul(h[3], s[4]))), Mul(h[4], s[3]));
+    d[3] = Add(Add(Add(Mul(h[0], r[3]), Mul(h[1], r[2])), Add(Mul(h[2], r[1]), Mul(h[3], r[0]))), Mul(h[4], s[4]));
+    d[4] = Add(Add(Add(Mul(h[0], r[4]), Mul(h[1], r[3])), Add(Mul(h[2], r[2]), Mul(h[3], r[1]))), Mul(h[4], r[0]));
+}
+
+} // namespace
+
+size_t Blocks_4way(uint32_t h[5], const uint32_t r[5], const unsigned char* m, size_t bytes) noexcept
+{
+    static constexpr size_t STEP{64};
+    static constexpr uint32_t HIBIT{1UL << 24}; // 1 << 128
+    if (bytes < 2 * STEP) return 0;
+
+    uint32_t pow[4][5]; // r^4, r^3, r^2, r
+    for (int i = 0; i < 5; ++i) pow[3][i] = r[i];
+    MulScalar(pow[2], pow[3], pow[3]);
+    MulScalar(pow[1], pow[2], pow[3]);
+    MulScalar(pow[0], pow[1], pow[3]);
+
+    __m256i r4[5], s4[5], rk[5], sk[5];
+    for (int i = 0; i < 5; ++i) {
+        r4[i] = K(pow[0][i]);
+        s4[i] = K(pow[0][i] * 5);
+        rk[i] = _mm256_set_epi64x(pow[3][i], pow[2][i], pow[1][i], pow[0][i]);
+        sk[i] = _mm256_set_epi64x(pow[3][i] * 5, pow[2][i] * 5, pow[1][i] * 5, pow[0][i] * 5);
+    }
+    const __m256i mask{K(0x3ffffff)};
+
+    __m256i acc[5], d[5];
+    for (int i = 0; i < 5; ++i) acc[i] = Add(Load4(m, i, HIBIT), _mm256_set_epi64x(0, 0, 0, h[i]));
+    size_t done{STEP};
+
+    while (bytes - done >= STEP) {
+        // acc = acc * r^4 + next four blocks, with a lane-wise partial reduction in between.
+        MulVec(d, acc, r4, s4);
+        __m256i c;
+                               c = ShR(d[0], 26); acc[0] = And(d[0], mask);
+        d[1] = Add(d[1], c);   c = ShR(d[1], 26); acc[1] = And(d[1], mask);
+        d[2] = Add(d[2], c);   c = ShR(d[2], 26); acc[2] = And(d[2], mask);
+        d[3] = Add(d[3], c);   c = ShR(d[3], 26); acc[3] = And(d[3], mask);
+        d[4] = Add(d[4], c);   c = ShR(d[4], 26); acc[4] = And(d[4], mask);
+        acc[0] = Add(acc[0], Add(c, ShL(c, 2)));
+        c = ShR(acc[0], 26); acc[0] = And(acc[0], mask); acc[1] = Add(acc[1], c);
+        for (int i = 0; i < 5; ++i) acc[i] = Add(acc[i], Load4(m + done, i, HIBIT));
+        done += STEP;
+    }
+
+    // Combine the lanes: lane k still needs a factor r^(4-k).
+    MulVec(d, acc, rk, sk);
+    uint64_t t[5][4];
+    for (int i = 0; i < 5; ++i) _mm256_storeu_si256((__m256i*)t[i], d[i]);
+    uint64_t d0 = t[0][0] + t[0][1] + t[0][2] + t[0][3];
+    uint64_t d1 = t[1][0] + t[1][1] + t[1][2] + t[1][3];
+    uint64_t d2 = t[2][0] + t[2][1] + t[2][2] + t[2][3];
+    uint64_t d3 = t[3][0] + t[3][1] + t[3][2] + t[3][3];
+    uint64_t d4 = t[4][0] + t[4][1] + t[4][2] + t[4][3];
+    uint64_t c;
+                  c = d0 >> 26; h[0] = (uint32_t)d0 & 0x3ffffff;
+    d1 += c;      c = d1 >> 26; h[1] = (uint32_t)d1 & 0x3ffffff;
+    d2 += c;      c = d2 >> 26; h[2] = (uint32_t)d2 & 0x3ffffff;
+    d3 += c;      c = d3 >> 26; h[3] = (uint32_t)d3 & 0x3ffffff;
+    d4 += c;      c = d4 >> 26; h[4] = (uint32_t)d4 & 0x3ffffff;
+    c = h[0] + c * 5;           h[0] = (uint32_t)c & 0x3ffffff;
+    h[1] += (uint32_t)(c >> 26);
+
+    return done;
+}
+
+} // namespace poly1305_avx2
+
+#endif
@@ -32,11 +32,13 @@ void Transform(uint32_t* s, const unsigned char* chunk, size_t blocks);
 namespace sha256d64_sse41
 {
 void Transform_4way(unsigned char* out, const unsigned char* in);
+void TransformMulti_4way(uint32_t* s, const unsigned char* const* chunks);
 }
 
 namespace sha256d64_avx2
 {
 void Transform_8way(unsigned char* out, const unsigned char* in);
+void TransformMulti_8way(uint32_t* s, const unsigned char* const* chunks);
 }
 
 namespace sha256d64_x86_shani
@@ -437,6 +439,8 @@ void TransformD64(unsigned char* out, const unsigned char* in)
 
 typedef void (*TransformType)(uint32_t*, const unsigned char*, size_t);
 typedef void (*TransformD64Type)(unsigned char*, const unsigned char*);
+/** Transform one 64-byte chunk per state, for N consecutive 8-word states. */
+typedef void (*TransformMultiType)(uint32_t*, const unsigned char* const*);
 
 template<TransformType tr>
 void TransformD64Wrapper(unsigned char* out, const unsigned char* in)
@@ -482,6 +486,25 @@ TransformD64Type TransformD64 = sha256::TransformD64;
 TransformD64Type TransformD64_2way = nullptr;
 TransformD64Type TransformD64_4way = nullptr;
 TransformD64Type TransformD64_8way = nullptr;
+TransformMultiType TransformMulti_4way = nullptr;
+TransformMultiType TransformMulti_8way = nullptr;
+
+/** Run a multi-state transform on 8 consecutive states, with chunks from the test data. */
+bool SelfTestMulti(TransformMultiType tr, size_t lanes, const uint32_t (&result)[9][8], const unsigned char* data)
+{
+    // Lane i starts from the state after hashing (i % 2) chunks, and processes the next one.
+    uint32_t state[8 * 8];
+    const unsigned char* chunks[8];
+    for (size_t i = 0; i < lanes; ++i) {
+        std::copy(result[i % 2], result[i % 2] + 8, state + 8 * i);
+        chunks[i] = data + 64 * (i % 2);
+    }
+    tr(state, chunks);
+    for (size_t i = 0; i < lanes; ++i) {
+        if (!std::equal(state + 8 * i, state + 8 * i + 8, result[i % 2 + 1])) return false;
+    }
+    return true;
+}
 
 bool SelfTest() {
     // Input state (equal to the initial SHA256 state)
@@ -565,6 +588,10 @@ bool SelfTest() {
         if (!std::equal(out, out + 256, result_d64)) return false;
     }
 
+    // Test TransformMulti_4way and TransformMulti_8way, if available.
+    if (TransformMulti_4way && !SelfTestMulti(TransformMulti_4way, 4, result, data + 1)) return false;
+    if (TransformMulti_8way && !SelfTestMulti(TransformMulti_8way, 8, result, data + 1)) return false;
+
     return true;
 }
 
@@ -590,6 +617,8 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
     TransformD64_2way = nullptr;
     TransformD64_4way = nullptr;
     TransformD64_8way = nullptr;
+    TransformMulti_4way = nullptr;
+    TransformMulti_8way = nullptr;
 
 #if !defined(DISABLE_OPTIMIZED_SHA256)
 #if defined(HAVE_GETCPUID)
@@ -639,6 +668,7 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
 #endif
 #if defined(ENABLE_SSE41)
         TransformD64_4way = sha256d64_sse41::Transform_4way;
+        TransformMulti_4way = sha256d64_sse41::TransformMulti_4way;
         ret += ";sse41(4way)";
 #endif
     }
@@ -646,6 +676,7 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
 #if defined(ENABLE_AVX2)
     if (have_avx2 && have_avx && enabled_avx) {
         TransformD64_8way = sha256d64_avx2::Transform_8way;
+        TransformMulti_8way = sha256d64_avx2::TransformMulti_8way;
         ret += ";avx2(8way)";
     }
 #endif
@@ -779,3 +810,123 @@ void SHA256D64(unsigned char* out, const unsigned char* in, size_t blocks)
         --blocks;
     }
 }
+
+namespace {
+/** One double-SHA256 computation in progress, fed to a multi-state transform one chunk at a time. */
+class DoubleHashLane
+{
+    //! Full 64-byte chunks of the input not yet transformed.
+    const unsigned char* m_data{nullptr};
+    size_t m_chunks{0};
+    //! Padded final chunks of the current message.
+    unsigned char m_tail[128];
+    size_t m_tail_chunks{0};
+    size_t m_tail_pos{0};
+    bool m_inner{true};
+
+public:
+    //! Index of the input being hashed.
+    size_t m_index{0};
+
+    void Start(uint32_t* s, std::span<const unsigned char> input, size_t index)
+    {
+        sha256::Initialize(s);
+        m_index = index;
+        m_inner = true;
+        m_data = input.data();
+        m_chunks = input.size() / 64;
+        const size_t rem{input.size() % 64};
+        if (rem) memcpy(m_tail, input.data() + 64 * m_chunks, rem);
+        m_tail_chunks = rem < 56 ? 1 : 2;
+        m_tail_pos = 0;
+        m_tail[rem] = 0x80;
+        memset(m_tail + rem + 1, 0, 64 * m_tail_chunks - rem - 9);
+        WriteBE64(m_tail + 64 * m_tail_chunks - 8, uint64_t{input.size()} << 3);
+    }
+
+    //! The next chunk to transform.
+    const unsigned char* Chunk() const { return m_chunks ? m_data : m_tail + 64 * m_tail_pos; }
+
+    //! Move past the chunk returned by Chunk(). Returns true once the outer hash is complete.
+    bool Next(uint32_t* s)
+    {
+        if (m_chunks) {
+            m_data += 64;
+            --m_chunks;
+            return false;
+        }
+        if (++m_tail_pos < m_tail_chunks) return false;
+        if (!m_inner) return true;
+        // Hash the 32-byte inner hash, which fits a single padded chunk.
+        for (int i = 0; i < 8; ++i) WriteBE32(m_tail + 4 * i, s[i]);
+        m_tail[32] = 0x80;
+        memset(m_tail + 33, 0, 31);
+        WriteBE64(m_tail + 56, 32 << 3);
+        sha256::Initialize(s);
+        m_tail_chunks = 1;
+        m_tail_pos = 0;
+        m_inner = false;
+        return false;
+    }
+
+    void Finish(const uint32_t* s, unsigned char* out) const
+    {
+        for (int i = 0; i < 8; ++i) WriteBE32(out + 32 * m_index + 4 * i, s[i]);
+    }
+};
+
+/** Double-SHA256 `count` >= N inputs, keeping all N states of a multi-state transform busy. */
+template <size_t N>
+void SHA256DManyNway(TransformMultiType tr, unsigned char* out, const std::span<const unsigned char>* in, size_t count)
+{
+    uint32_t s[8 * N];
+    DoubleHashLane lanes[N];
+    size_t next{0};
+    for (size_t i = 0; i < N; ++i, ++next) lanes[i].Start(s + 8 * i, in[next], next);
+
+    // Refill each lane as soon as its hash is complete, until the inputs run out.
+    bool done[N] = {};
+    bool exhausted{false};
+    while (!exhausted) {
+        const unsigned char* chunks[N];
+        for (size_t i = 0; i < N; ++i) chunks[i] = lanes[i].Chunk();
+        tr(s, chunks);
+        for (size_t i = 0; i < N; ++i) {
+            if (!lanes[i].Next(s + 8 * i)) continue;
+            lanes[i].Finish(s + 8 * i, out);
+            if (next < count) {
+                lanes[i].Start(s + 8 * i, in[next], next);
+                ++next;
+            } else {
+                done[i] = true;
+                exhausted = true;
+            }
+        }
+    }
+
+    // Complete the hashes still in progress one at a time.
+    for (size_t i = 0; i < N; ++i) {
+        if (done[i]) continue;
+        do {
+            Transform(s + 8 * i, lanes[i].Chunk(), 1);
+        } while (!lanes[i].Next(s + 8 * i));
+        lanes[i].Finish(s + 8 * i, out);
+    }
+}
+} // namespace
+
+bool SHA256DManyIsMultiLane()
+{
+    return TransformMulti_4way || TransformMulti_8way;
+}
+
+void SHA256DMany(unsigned char* out, const std::span<const unsigned char>* in, size_t count)
+{
+    if (TransformMulti_8way && count >= 8) return SHA256DManyNway<8>(TransformMulti_8way, out, in, count);
+    if (TransformMulti_4way && count >= 4) return SHA256DManyNway<4>(TransformMulti_4way, out, in, count);
+    for (size_t i = 0; i < count; ++i) {
+        unsigned char inner[CSHA256::OUTPUT_SIZE];
+        CSHA256().Write(in[i].data(), in[i].size()).Finalize(inner);
+        CSHA256().Write(inner, sizeof(inner)).Finalize(out + 32 * i);
+    }
+}
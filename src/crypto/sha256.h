@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <span>
 #include <string>
 
 /** A hasher class for SHA-256. */
@@ -50,4 +51,17 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
  */
 void SHA256D64(unsigned char* output, const unsigned char* input, size_t blocks);
 
+/** Compute multiple double-SHA256's of variable-length inputs.
+ *  Interleaves the inputs in the lanes of the 4-way/8-way implementations
+ *  when available.
+ *  output:  pointer to a count*32 byte output buffer
+ *  inputs:  pointer to count inputs
+ *  count:   the number of hashes to compute.
+ */
+void SHA256DMany(unsigned char* output, const std::span<const unsigned char>* inputs, size_t count);
+
+/** Whether SHA256DMany() has a multi-lane implementation available, rather
+ *  than hashing the inputs one at a time. */
+bool SHA256DManyIsMultiLane();
+
 #endif // BITCOIN_CRYPTO_SHA256_H
@@ -4,12 +4,25 @@
 
 #include <crypto/siphash.h>
 
+#include <compat/cpuid.h> // IWYU pragma: keep
 #include <uint256.h>
 
 #include <bit>
 #include <cassert>
 #include <span>
 
+#if defined(ENABLE_AVX2)
+namespace siphash_avx2 {
+size_t Uint256_4way(const SipHashState& state, std::span<const uint256* const> vals, std::span<uint64_t> out) noexcept;
+}
+#endif
+
+#if defined(ENABLE_AVX512)
+namespace siphash_avx512 {
+size_t Uint256_8way(const SipHashState& state, std::span<const uint256* const> vals, std::span<uint64_t> out) noexcept;
+}
+#endif
+
 #define SIPROUND do { \
     v0 += v1; v1 = std::rotl(v1, 13); v1 ^= v0; \
     v0 = std::rotl(v0, 32); \
@@ -160,3 +173,34 @@ uint64_t PresaltedSipHasher::operator()(const uint256& val, uint32_t extra) cons
     SIPROUND;
     return v0 ^ v1 ^ v2 ^ v3;
 }
+
+namespace {
+
+using Uint256MultiFn = size_t (*)(const SipHashState& state, std::span<const uint256* const> vals, std::span<uint64_t> out) noexcept;
+
+/** Widest multi-lane implementation usable on this CPU, or nullptr. */
+Uint256MultiFn DetectUint256Multi()
+{
+#if defined(HAVE_GETCPUID)
+#if defined(ENABLE_AVX512)
+    if (HaveAVX512F()) return siphash_avx512::Uint256_8way;
+#endif
+#if defined(ENABLE_AVX2)
+    if (HaveAVX2()) return siphash_avx2::Uint256_4way;
+#endif
+#endif // defined(HAVE_GETCPUID)
+    return nullptr;
+}
+
+} // namespace
+
+void PresaltedSipHasher::operator()(std::span<const uint256* const> vals, std::span<uint64_t> out) const noexcept
+{
+    assert(vals.size() == out.size());
+    static const Uint256MultiFn multi{DetectUint256Multi()};
+    size_t done{0};
+    if (multi != nullptr) done = multi(m_state, vals, out);
+    for (; done < vals.size(); ++done) {
+        out[done] = (*this)(*vals[done]);
+    }
+}
@@ -6,6 +6,7 @@
 #define BITCOIN_CRYPTO_SIPHASH_H
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <span>
 
@@ -67,6 +68,13 @@ public:
      * with `extra` encoded as 4 little-endian bytes.
      */
     uint64_t operator()(const uint256& val, uint32_t extra) const noexcept;
+
+    /**
+     * Equivalent to out[i] = (*this)(*vals[i]) for every i, but hashes several
+     * values at once using SIMD instructions where the CPU supports them.
+     * vals and out must have the same size.
+     */
+    void operator()(std::span<const uint256* const> vals, std::span<uint64_t> out) const noexcept;
 };
 
 #endif // BITCOIN_CRYPTO_SIPHASH_H
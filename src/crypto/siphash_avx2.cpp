@@ -0,0 +1,20 @@
+// Copyright (c) 2025-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <crypto/siphash_vec.ipp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace siphash_avx2 {
+size_t Uint256_4way(const SipHashState& state, std::span<const uint256* const> vals, std::span<uint64_t> out) noexcept
+{
+    return SipHashUint256Multi<vec64x4>(state, vals, out);
+}
+} // namespace siphash_avx2
+
+#endif
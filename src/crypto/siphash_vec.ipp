@@ -0,0 +1,77 @@
+// Copyright (c) 2025-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Multi-lane SipHash-2-4 of uint256 values using GCC/Clang vector extensions,
+// one hash per vector lane. This file is included by translation units
+// compiled with different target flags (see siphash_avx2.cpp and
+// siphash_avx512.cpp), so everything in it has internal linkage.
+
+#include <crypto/siphash.h>
+#include <uint256.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+namespace {
+
+typedef uint64_t vec64x4 __attribute__((vector_size(32)));
+typedef uint64_t vec64x8 __attribute__((vector_size(64)));
+
+template <int BITS, typename Vec>
+inline Vec RotL(Vec x) { return (x << BITS) | (x >> (64 - BITS)); }
+
+template <typename Vec>
+inline void SipRound(Vec& v0, Vec& v1, Vec& v2, Vec& v3)
+{
+    v0 += v1; v1 = RotL<13>(v1); v1 ^= v0;
+    v0 = RotL<32>(v0);
+    v2 += v3; v3 = RotL<16>(v3); v3 ^= v2;
+    v0 += v3; v3 = RotL<21>(v3); v3 ^= v0;
+    v2 += v1; v1 = RotL<17>(v1); v1 ^= v2;
+    v2 = RotL<32>(v2);
+}
+
+/** Word pos of vals[0..LANES), one per lane. */
+template <typename Vec, size_t... I>
+inline Vec LoadWord(const uint256* const* vals, int pos, std::index_sequence<I...>)
+{
+    return Vec{vals[I]->GetUint64(pos)...};
+}
+
+/** Hash as many groups of one value per lane of Vec as fit in vals into out, like
+ *  PresaltedSipHasher::operator()(const uint256&). Returns the number of values hashed. */
+template <typename Vec>
+size_t SipHashUint256Multi(const SipHashState& state, std::span<const uint256* const> vals, std::span<uint64_t> out) noexcept
+{
+    static constexpr size_t LANES{sizeof(Vec) / sizeof(uint64_t)};
+    static constexpr auto LANE_INDICES{std::make_index_sequence<LANES>()};
+
+    size_t done{0};
+    for (; vals.size() - done >= LANES; done += LANES) {
+        Vec v0 = Vec{} + state.v[0], v1 = Vec{} + state.v[1], v2 = Vec{} + state.v[2], v3 = Vec{} + state.v[3];
+        for (int pos = 0; pos < 4; ++pos) {
+            const Vec d{LoadWord<Vec>(vals.data() + done, pos, LANE_INDICES)};
+            v3 ^= d;
+            SipRound(v0, v1, v2, v3);
+            SipRound(v0, v1, v2, v3);
+            v0 ^= d;
+        }
+        v3 ^= uint64_t{4} << 59;
+        SipRound(v0, v1, v2, v3);
+        SipRound(v0, v1, v2, v3);
+        v0 ^= uint64_t{4} << 59;
+        v2 ^= 0xFF;
+        SipRound(v0, v1, v2, v3);
+        SipRound(v0, v1, v2, v3);
+        SipRound(v0, v1, v2, v3);
+        SipRound(v0, v1, v2, v3);
+        const Vec result{v0 ^ v1 ^ v2 ^ v3};
+        for (size_t lane = 0; lane < LANES; ++lane) out[done + lane] = result[lane];
+    }
+    return done;
+}
+
+} // namespace
@@ -482,6 +482,21 @@ public:
             }
         return false;
     }
+
+    /** for_each calls `f` on every element which has not been marked for
+     * garbage collection, e.g. to persist the contents of the cache.
+     *
+     * Must not be called concurrently with insert.
+     *
+     * @param f the callable to invoke with each element
+     */
+    template <typename F>
+    void for_each(F f) const
+    {
+        for (uint32_t i = 0; i < size; ++i)
+            if (!collection_flags.bit_is_set(i))
+                f(table[i]);
+    }
 };
 } // namespace CuckooCache
 
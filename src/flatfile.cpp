@@ -113,3 +113,18 @@ bool FlatFileSeq::Flush(const FlatFilePos& pos, bool finalize) const
     }
     return true;
 }
+
+bool FlatFileSeq::DropCache(const FlatFilePos& pos) const
+{
+    FILE* file = Open(FlatFilePos(pos.nFile, 0), /*read_only=*/true);
+    if (!file) {
+        LogError("%s: failed to open file %d\n", __func__, pos.nFile);
+        return false;
+    }
+    DropFileCache(file);
+    if (fclose(file) != 0) {
+        LogError("Failed to close file %d after dropping its cache", pos.nFile);
+        return false;
+    }
+    return true;
+}
@@ -80,6 +80,16 @@ public:
      * @return true on success, false on failure.
      */
     bool Flush(const FlatFilePos& pos, bool finalize = false) const;
+
+    /**
+     * Advise the OS to evict a file from its page cache. Only data that has
+     * been committed to disk is evicted, and the file is read from disk again
+     * when it is next accessed.
+     *
+     * @param[in] pos Any position in the file.
+     * @return true on success, false on failure.
+     */
+    bool DropCache(const FlatFilePos& pos) const;
 };
 
 #endif // BITCOIN_FLATFILE_H
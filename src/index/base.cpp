@@ -16,6 +16,7 @@
 #include <node/database_args.h>
 #include <node/interface_ui.h>
 #include <primitives/block.h>
+#include <streams.h>
 #include <sync.h>
 #include <tinyformat.h>
 #include <uint256.h>
@@ -33,6 +34,7 @@
 #include <cassert>
 #include <compare>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <span>
@@ -48,6 +50,8 @@ constexpr uint8_t DB_BEST_BLOCK{'B'};
 
 constexpr auto SYNC_LOG_INTERVAL{30s};
 constexpr auto SYNC_LOCATOR_WRITE_INTERVAL{30s};
+//! Number of blocks read ahead at once during sync when -blockreadthreads is set
+constexpr size_t SYNC_READ_AHEAD_BLOCKS{16};
 
 template <typename... Args>
 void BaseIndex::FatalErrorf(util::ConstevalFormatString<sizeof...(Args)> fmt, const Args&... args)
@@ -165,6 +169,40 @@ static const CBlockIndex* NextSyncBlock(const CBlockIndex* pindex_prev, CChain&
     return chain.Next(chain.FindFork(pindex_prev));
 }
 
+using ReadAheadBlocks = std::deque<std::pair<const CBlockIndex*, std::shared_ptr<const CBlock>>>;
+
+//! Read pindex and the blocks following it on the active chain, concurrently
+//! on the block read threads. Reading stops at the first block that is
+//! missing or fails to read; the caller reads that one on its own.
+static ReadAheadBlocks ReadBlocksAhead(Chainstate& chainstate, const CBlockIndex* pindex)
+{
+    std::vector<const CBlockIndex*> indexes;
+    std::vector<FlatFilePos> positions;
+    {
+        LOCK(cs_main);
+        for (; pindex && indexes.size() < SYNC_READ_AHEAD_BLOCKS; pindex = chainstate.m_chain.Next(pindex)) {
+            if (!(pindex->nStatus & BLOCK_HAVE_DATA)) break;
+            indexes.push_back(pindex);
+            positions.push_back(pindex->GetBlockPos());
+        }
+    }
+
+    ReadAheadBlocks blocks;
+    const auto results{chainstate.m_blockman.ReadRawBlocks(positions)};
+    for (size_t i{0}; i < results.size(); ++i) {
+        if (!results[i]) break;
+        auto block{std::make_shared<CBlock>()};
+        try {
+            SpanReader{*results[i]} >> TX_WITH_WITNESS(*block);
+        } catch (const std::exception&) {
+            break;
+        }
+        if (block->GetHash() != indexes[i]->GetBlockHash()) break;
+        blocks.emplace_back(indexes[i], std::move(block));
+    }
+    return blocks;
+}
+
 bool BaseIndex::ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data)
 {
     interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex, block_data);
@@ -202,6 +240,8 @@ void BaseIndex::Sync()
 {
     const CBlockIndex* pindex = m_best_block_index.load();
     if (!m_synced) {
+        const bool read_ahead{m_chainstate->m_blockman.GetBlockReadThreads() > 0};
+        ReadAheadBlocks blocks_ahead;
         auto last_log_time{NodeClock::now()};
         auto last_locator_write_time{last_log_time};
         while (true) {
@@ -242,8 +282,19 @@ void BaseIndex::Sync()
             }
             pindex = pindex_next;
 
+            std::shared_ptr<const CBlock> block;
+            if (read_ahead) {
+                // Blocks read ahead for a chain that has since been reorged away are dropped.
+                if (blocks_ahead.empty() || blocks_ahead.front().first != pindex) {
+                    blocks_ahead = ReadBlocksAhead(*m_chainstate, pindex);
+                }
+                if (!blocks_ahead.empty() && blocks_ahead.front().first == pindex) {
+                    block = std::move(blocks_ahead.front().second);
+                    blocks_ahead.pop_front();
+                }
+            }
 
-            if (!ProcessBlock(pindex)) return; // error logged internally
+            if (!ProcessBlock(pindex, block.get())) return; // error logged internally
 
             auto current_time{NodeClock::now()};
             if (current_time - last_log_time >= SYNC_LOG_INTERVAL) {
@@ -0,0 +1,298 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_INPUTFETCHER_H
+#define BITCOIN_INPUTFETCHER_H
+
+#include <coins.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <uint256.h>
+#include <util/hasher.h>
+#include <util/log.h>
+#include <util/threadpool.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/**
+ * Warms a CCoinsViewCache with the inputs of a block before it is connected.
+ *
+ * During IBD, ConnectBlock spends most of its time faulting coins in from the
+ * on-disk UTXO set one outpoint at a time. Reads from the database are
+ * thread-safe, so the block's input outpoints that are missing from the cache
+ * are split into chunks and looked up concurrently on a ThreadPool. The master
+ * thread helps draining the pool and then inserts the fetched coins into the
+ * cache as clean (neither DIRTY nor FRESH) entries, exactly as a regular cache
+ * miss would have done.
+ *
+ * The inputs of the next block can also be fetched ahead of time with
+ * FetchNextInputs(), so that its database reads overlap with the script checks
+ * of the block being connected. See FetchNextInputs() for the conditions under
+ * which these coins can be used.
+ *
+ * Only the master thread ever touches the cache, so the cache does not need to
+ * be thread-safe. The database must not be written to while lookups are
+ * running, which is guaranteed by holding cs_main for the whole call to
+ * FetchInputs(), and until WaitForNextInputs() returns for FetchNextInputs().
+ */
+class InputFetcher
+{
+private:
+    //! Minimum number of outpoints handed to a single task, so that tiny
+    //! blocks don't pay for more task dispatch overhead than lookups.
+    static constexpr size_t MIN_CHUNK_SIZE{16};
+
+    //! Outpoints to look up, the coins found for them and the tasks looking them up.
+    struct Batch {
+        std::vector<COutPoint> outpoints;
+        std::vector<std::optional<Coin>> coins;
+        std::vector<std::future<void>> futures;
+    };
+
+    ThreadPool m_pool{"inputfetch"};
+    const int m_worker_threads_num;
+
+    //! Reused between calls to avoid reallocating per block.
+    Batch m_batch;
+
+    //! Inputs of m_next_block, fetched while its parent is being connected.
+    Batch m_next_batch;
+    std::shared_ptr<const CBlock> m_next_block;
+    uint256 m_next_hash;
+    //! Cache the next inputs were collected against, and the block it must be at to use them.
+    const CCoinsViewCache* m_next_cache{nullptr};
+    uint256 m_next_parent;
+
+    //! Outpoints added to a cache since the last UseNextInputs() call, for UncacheInputs().
+    std::vector<COutPoint> m_added;
+
+    /**
+     * Append the inputs of `block` that have no entry in `cache` and are not
+     * created earlier in the same block to `outpoints`. Spent entries are
+     * skipped too: the database may still hold the coin unspent until the
+     * spend is flushed.
+     *
+     * @param[in] skip_txids  Txids whose outputs must be skipped. Updated with the block's own txids.
+     * @param[in] skip        Outpoints to skip, if not null.
+     */
+    static void CollectInputs(const CCoinsViewCache& cache, const CBlock& block,
+                              std::unordered_set<Txid, SaltedTxidHasher>& skip_txids,
+                              const std::unordered_set<COutPoint, SaltedOutpointHasher>* skip,
+                              std::vector<COutPoint>& outpoints)
+    {
+        for (const auto& tx : block.vtx) {
+            if (!tx->IsCoinBase()) {
+                for (const auto& txin : tx->vin) {
+                    const auto& prevout{txin.prevout};
+                    // Outputs created in this block can't be in the database yet.
+                    if (skip_txids.contains(prevout.hash)) continue;
+                    if (skip && skip->contains(prevout)) continue;
+                    if (cache.HaveEntryInCache(prevout)) continue;
+                    outpoints.emplace_back(prevout);
+                }
+            }
+            skip_txids.insert(tx->GetHash());
+        }
+    }
+
+    /** Split the lookups of `batch` into tasks and submit them to the pool. */
+    void StartFetch(const CCoinsView& db, Batch& batch)
+    {
+        batch.coins.clear();
+        batch.coins.resize(batch.outpoints.size());
+        batch.futures.clear();
+
+        const size_t num_tasks{size_t(m_worker_threads_num) + 1};
+        const size_t chunk_size{std::max(MIN_CHUNK_SIZE, (batch.outpoints.size() + num_tasks - 1) / num_tasks)};
+        for (size_t begin{0}; begin < batch.outpoints.size(); begin += chunk_size) {
+            const size_t end{std::min(begin + chunk_size, batch.outpoints.size())};
+            auto fetch_chunk{[&db, &batch, begin, end] {
+                for (size_t i{begin}; i < end; ++i) {
+                    batch.coins[i] = db.PeekCoin(batch.outpoints[i]);
+                }
+            }};
+            if (auto future{m_pool.Submit(fetch_chunk)}) {
+                batch.futures.emplace_back(std::move(*future));
+            } else {
+                fetch_chunk();
+            }
+        }
+    }
+
+    /** Wait for all tasks of `batch`, helping the workers out instead of blocking right away. */
+    void WaitForFetch(Batch& batch)
+    {
+        while (m_pool.ProcessTask()) {}
+        // All tasks must have finished before an exception leaves the batch unguarded.
+        for (auto& future : batch.futures) future.wait();
+        auto futures{std::move(batch.futures)};
+        batch.futures.clear();
+        // Rethrows any exception raised by a database read.
+        for (auto& future : futures) future.get();
+    }
+
+    size_t InsertFetched(CCoinsViewCache& cache, Batch& batch)
+    {
+        size_t fetched{0};
+        for (size_t i{0}; i < batch.outpoints.size(); ++i) {
+            if (auto& coin{batch.coins[i]}) {
+                if (cache.PrefetchCoin(batch.outpoints[i], std::move(*coin))) {
+                    m_added.push_back(batch.outpoints[i]);
+                    ++fetched;
+                }
+            }
+        }
+        return fetched;
+    }
+
+public:
+    //! Create a fetcher with `worker_threads_num` threads. Zero disables prefetching.
+    explicit InputFetcher(int worker_threads_num) : m_worker_threads_num{worker_threads_num}
+    {
+        if (m_worker_threads_num > 0) {
+            LogInfo("Block input prefetching uses %d threads", m_worker_threads_num);
+            m_pool.Start(m_worker_threads_num);
+        }
+    }
+
+    ~InputFetcher() { DiscardNextInputs(); }
+
+    InputFetcher(const InputFetcher&) = delete;
+    InputFetcher& operator=(const InputFetcher&) = delete;
+
+    bool HasThreads() const { return m_worker_threads_num > 0; }
+
+    /**
+     * Fetch all inputs of `block` that are neither in `cache` nor created
+     * earlier in the same block from `db`, and add them to `cache` without
+     * marking them dirty.
+     *
+     * @param[in,out] cache  The cache ConnectBlock will read through.
+     * @param[in]     db     The view backing `cache`. Must be safe for concurrent reads.
+     * @param[in]     block  The block about to be connected.
+     * @returns the number of coins added to the cache.
+     */
+    size_t FetchInputs(CCoinsViewCache& cache, const CCoinsView& db, const CBlock& block)
+    {
+        if (!HasThreads() || block.vtx.size() <= 1) return 0;
+
+        m_batch.outpoints.clear();
+        std::unordered_set<Txid, SaltedTxidHasher> block_txids{};
+        block_txids.reserve(block.vtx.size());
+        CollectInputs(cache, block, block_txids, /*skip=*/nullptr, m_batch.outpoints);
+        if (m_batch.outpoints.empty()) return 0;
+
+        StartFetch(db, m_batch);
+        WaitForFetch(m_batch);
+        return InsertFetched(cache, m_batch);
+    }
+
+    /**
+     * Start fetching the inputs of `next_block` from `db` in the background,
+     * while `block`, its parent, is connected on top of `cache`. Returns
+     * immediately. Any previously started fetch is discarded.
+     *
+     * The lookups race with the connection of `block`, so their results are
+     * only valid for outpoints the connection does not touch: inputs that are
+     * in `cache` already, that are spent by `block`, or that are created in
+     * `block` or `next_block` are skipped, and left to the regular lookup
+     * once `block` has been connected. The coins are only handed out by
+     * UseNextInputs() if `cache` is then at `block`, and the caller must
+     * DiscardNextInputs() whenever a block is disconnected from `cache` or
+     * `cache` is flushed, as a flush drops the spent entries the lookups
+     * were filtered against.
+     *
+     * WaitForNextInputs() must be called before `db` is written to.
+     */
+    void FetchNextInputs(const CCoinsViewCache& cache, const CCoinsView& db, const CBlock& block, std::shared_ptr<const CBlock> next_block)
+    {
+        DiscardNextInputs();
+        if (!HasThreads()) return;
+
+        m_next_batch.outpoints.clear();
+        std::unordered_set<Txid, SaltedTxidHasher> skip_txids{};
+        std::unordered_set<COutPoint, SaltedOutpointHasher> parent_spent{};
+        skip_txids.reserve(block.vtx.size() + next_block->vtx.size());
+        for (const auto& tx : block.vtx) {
+            if (!tx->IsCoinBase()) {
+                for (const auto& txin : tx->vin) parent_spent.insert(txin.prevout);
+            }
+            skip_txids.insert(tx->GetHash());
+        }
+        CollectInputs(cache, *next_block, skip_txids, &parent_spent, m_next_batch.outpoints);
+
+        m_next_hash = next_block->GetHash();
+        m_next_block = std::move(next_block);
+        m_next_cache = &cache;
+        m_next_parent = block.GetHash();
+        StartFetch(db, m_next_batch);
+    }
+
+    /** Block until the lookups started by FetchNextInputs(), if any, have completed. */
+    void WaitForNextInputs()
+    {
+        try {
+            WaitForFetch(m_next_batch);
+        } catch (...) {
+            DiscardNextInputs();
+            throw;
+        }
+    }
+
+    /**
+     * If the inputs of the block with hash `block_hash` were fetched ahead of
+     * time against `cache`, and `cache` is at the block's parent, add them to
+     * `cache` without marking them dirty.
+     *
+     * @returns the block passed to FetchNextInputs() and the number of coins
+     *          added to the cache, or nullptr and zero if there was no usable
+     *          fetch. Any previously started fetch is consumed either way.
+     */
+    std::pair<std::shared_ptr<const CBlock>, size_t> UseNextInputs(CCoinsViewCache& cache, const uint256& block_hash)
+    {
+        m_added.clear();
+        if (!m_next_block) return {nullptr, 0};
+        WaitForNextInputs();
+        if (m_next_cache != &cache || m_next_hash != block_hash || cache.GetBestBlock() != m_next_parent) {
+            DiscardNextInputs();
+            return {nullptr, 0};
+        }
+        const size_t fetched{InsertFetched(cache, m_next_batch)};
+        auto block{std::move(m_next_block)};
+        DiscardNextInputs();
+        return {std::move(block), fetched};
+    }
+
+    /**
+     * Remove the coins added to `cache` by FetchInputs() and UseNextInputs()
+     * since the last UseNextInputs() call again, unless they have been
+     * modified since. Called when the block they were fetched for fails to
+     * connect, so that an invalid block does not fill the cache.
+     */
+    void UncacheInputs(CCoinsViewCache& cache)
+    {
+        for (const auto& outpoint : m_added) cache.Uncache(outpoint);
+        m_added.clear();
+    }
+
+    /** Drop the inputs fetched by FetchNextInputs(), waiting for any lookups still running. */
+    void DiscardNextInputs()
+    {
+        for (auto& future : m_next_batch.futures) future.wait();
+        m_next_batch.futures.clear();
+        m_next_batch.outpoints.clear();
+        m_next_batch.coins.clear();
+        m_next_block.reset();
+        m_next_cache = nullptr;
+    }
+};
+
+#endif // BITCOIN_INPUTFETCHER_H
@@ -9,6 +9,7 @@
 #include <kernel/notifications_interface.h>
 #include <util/fs.h>
 
+#include <cstddef>
 #include <cstdint>
 
 class CChainParams;
@@ -16,6 +17,13 @@ class CChainParams;
 namespace kernel {
 
 static constexpr bool DEFAULT_XOR_BLOCKSDIR{true};
+static constexpr bool DEFAULT_BLOCKS_MMAP{false};
+static constexpr bool DEFAULT_ASYNC_BLOCK_WRITES{false};
+static constexpr bool DEFAULT_ASYNC_PRUNE{false};
+static constexpr bool DEFAULT_BLOCKS_DROP_CACHE{false};
+static constexpr size_t DEFAULT_BLOCK_READ_CACHE{0};
+static constexpr int DEFAULT_BLOCK_READ_THREADS{0};
+static constexpr int MAX_BLOCK_READ_THREADS{16};
 
 /**
  * An options struct for `BlockManager`, more ergonomically referred to as
@@ -24,6 +32,18 @@ static constexpr bool DEFAULT_XOR_BLOCKSDIR{true};
 struct BlockManagerOpts {
     const CChainParams& chainparams;
     bool use_xor{DEFAULT_XOR_BLOCKSDIR};
+    //! Serve raw block reads from memory mappings of finalized block files.
+    bool use_mmap{DEFAULT_BLOCKS_MMAP};
+    //! Write block and undo data, and flush their files, on a background thread.
+    bool async_writes{DEFAULT_ASYNC_BLOCK_WRITES};
+    //! Delete pruned block and undo files on a background thread.
+    bool async_prune{DEFAULT_ASYNC_PRUNE};
+    //! Evict finalized block files from the OS page cache once the tip has passed their blocks.
+    bool drop_cache{DEFAULT_BLOCKS_DROP_CACHE};
+    //! Memory used to cache recently read blocks, 0 to disable.
+    size_t block_cache_bytes{DEFAULT_BLOCK_READ_CACHE};
+    //! Threads used to serve batches of raw block reads concurrently, 0 to read them in sequence.
+    int block_read_threads{DEFAULT_BLOCK_READ_THREADS};
     uint64_t prune_target{0};
     bool fast_prune{false};
     const fs::path blocks_dir;
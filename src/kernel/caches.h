@@ -13,6 +13,8 @@
 static constexpr size_t DEFAULT_KERNEL_CACHE{450_MiB};
 //! Default LevelDB write batch size
 static constexpr size_t DEFAULT_DB_CACHE_BATCH{32_MiB};
+//! Default for writing coins cache flushes to disk on a background thread
+static constexpr bool DEFAULT_COINS_ASYNC_FLUSH{false};
 
 //! Max memory allocated to block tree DB specific cache (bytes)
 static constexpr size_t MAX_BLOCK_DB_CACHE{2_MiB};
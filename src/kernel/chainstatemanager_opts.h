@@ -46,6 +46,10 @@ struct ChainstateManagerOpts {
     ValidationSignals* signals{nullptr};
     //! Number of script check worker threads. Zero means no parallel verification.
     int worker_threads_num{0};
+    //! Whether script check threads share work through per-thread work-stealing deques instead of a single queue.
+    bool script_check_work_stealing{false};
+    //! Number of threads prefetching block inputs from the coins database. Zero means no prefetching.
+    int input_fetch_threads_num{0};
     size_t script_execution_cache_bytes{DEFAULT_SCRIPT_EXECUTION_CACHE_BYTES};
     size_t signature_cache_bytes{DEFAULT_SIGNATURE_CACHE_BYTES};
 };
@@ -880,16 +880,27 @@ Transport::BytesToSend V1Transport::GetBytesToSend(bool have_next_message) const
     }
 }
 
+std::span<const uint8_t> V1Transport::GetNextBytesToSend() const noexcept
+{
+    AssertLockNotHeld(m_send_mutex);
+    LOCK(m_send_mutex);
+    if (m_sending_header) return m_message_to_send.data;
+    return {};
+}
+
 void V1Transport::MarkBytesSent(size_t bytes_sent) noexcept
 {
     AssertLockNotHeld(m_send_mutex);
     LOCK(m_send_mutex);
     m_bytes_sent += bytes_sent;
-    if (m_sending_header && m_bytes_sent == m_header_to_send.size()) {
-        // We're done sending a message's header. Switch to sending its data bytes.
+    if (m_sending_header && m_bytes_sent >= m_header_to_send.size()) {
+        // We're done sending a message's header. Switch to sending its data bytes, some of which
+        // may have been sent along with the header.
         m_sending_header = false;
-        m_bytes_sent = 0;
-    } else if (!m_sending_header && m_bytes_sent == m_message_to_send.data.size()) {
+        m_bytes_sent -= m_header_to_send.size();
+        Assume(m_bytes_sent <= m_message_to_send.data.size());
+    }
+    if (!m_sending_header && m_bytes_sent == m_message_to_send.data.size()) {
         // We're done sending a message's data. Wipe the data vector to reduce memory consumption.
         ClearShrink(m_message_to_send.data);
         m_bytes_sent = 0;
@@ -970,6 +981,52 @@ public:
 
 const V2MessageMap V2_MESSAGE_MAP;
 
+/** Send buffers of V2Transports that finished sending, kept to be reused for later messages
+ *  instead of allocating a new buffer for every message. */
+class SendBufferPool
+{
+    /** Maximum number of pooled buffers. */
+    static constexpr size_t MAX_BUFFERS{64};
+    /** Maximum total capacity of the pooled buffers. */
+    static constexpr size_t MAX_BYTES{32 << 20};
+
+    Mutex m_mutex;
+    std::vector<std::vector<uint8_t>> m_buffers GUARDED_BY(m_mutex);
+    size_t m_bytes GUARDED_BY(m_mutex){0};
+
+public:
+    /** Take the smallest pooled buffer with a capacity of at least size, or an empty one. */
+    std::vector<uint8_t> Take(size_t size) noexcept EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        auto best{m_buffers.end()};
+        for (auto it{m_buffers.begin()}; it != m_buffers.end(); ++it) {
+            if (it->capacity() >= size && (best == m_buffers.end() || it->capacity() < best->capacity())) best = it;
+        }
+        if (best == m_buffers.end()) return {};
+        std::vector<uint8_t> ret{std::move(*best)};
+        *best = std::move(m_buffers.back());
+        m_buffers.pop_back();
+        m_bytes -= ret.capacity();
+        return ret;
+    }
+
+    /** Return a buffer to the pool, or free it if the pool is full. */
+    void Give(std::vector<uint8_t>&& buffer) noexcept EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        if (buffer.capacity() == 0 || m_buffers.size() >= MAX_BUFFERS || m_bytes + buffer.capacity() > MAX_BYTES) {
+            ClearShrink(buffer);
+            return;
+        }
+        buffer.clear();
+        m_bytes += buffer.capacity();
+        m_buffers.push_back(std::move(buffer));
+    }
+};
+
+SendBufferPool g_send_buffer_pool;
+
 std::vector<uint8_t> GenerateRandomGarbage() noexcept
 {
     std::vector<uint8_t> ret;
@@ -1485,22 +1542,22 @@ bool V2Transport::SetMessageToSend(CSerializedNetMsg& msg) noexcept
     // is available) and the send buffer is empty. This limits the number of messages in the send
     // buffer to just one, and leaves the responsibility for queueing them up to the caller.
     if (!(m_send_state == SendState::READY && m_send_buffer.empty())) return false;
-    // Construct contents (encoding message type + payload).
-    std::vector<uint8_t> contents;
+    // Construct contents (encoding message type + payload) in a pooled send buffer, where the
+    // ciphertext of the contents will be, and encrypt them in place.
     auto short_message_id = V2_MESSAGE_MAP(msg.m_type);
+    const size_t type_size{short_message_id ? 1 : 1 + CMessageHeader::MESSAGE_TYPE_SIZE};
+    const size_t contents_size{type_size + msg.data.size()};
+    m_send_buffer = g_send_buffer_pool.Take(contents_size + BIP324Cipher::EXPANSION);
+    // Initialize with zeroes. Without a short message id, the message type string is written
+    // starting at offset 1, so contents[0] and the unused positions in contents[1..13] remain 0x00.
+    m_send_buffer.resize(contents_size + BIP324Cipher::EXPANSION, 0);
+    const auto contents{std::span{m_send_buffer}.subspan(BIP324Cipher::LENGTH_LEN + BIP324Cipher::HEADER_LEN, contents_size)};
     if (short_message_id) {
-        contents.resize(1 + msg.data.size());
         contents[0] = *short_message_id;
-        std::copy(msg.data.begin(), msg.data.end(), contents.begin() + 1);
     } else {
-        // Initialize with zeroes, and then write the message type string starting at offset 1.
-        // This means contents[0] and the unused positions in contents[1..13] remain 0x00.
-        contents.resize(1 + CMessageHeader::MESSAGE_TYPE_SIZE + msg.data.size(), 0);
-        std::copy(msg.m_type.begin(), msg.m_type.end(), contents.data() + 1);
-        std::copy(msg.data.begin(), msg.data.end(), contents.begin() + 1 + CMessageHeader::MESSAGE_TYPE_SIZE);
-    }
-    // Construct ciphertext in send buffer.
-    m_send_buffer.resize(contents.size() + BIP324Cipher::EXPANSION);
+        std::copy(msg.m_type.begin(), msg.m_type.end(), contents.begin() + 1);
+    }
+    std::copy(msg.data.begin(), msg.data.end(), contents.begin() + type_size);
     m_cipher.Encrypt(MakeByteSpan(contents), {}, false, MakeWritableByteSpan(m_send_buffer));
     m_send_type = msg.m_type;
     // Release memory
@@ -1540,13 +1597,22 @@ void V2Transport::MarkBytesSent(size_t bytes_sent) noexcept
     if (m_send_pos >= CMessageHeader::HEADER_SIZE) {
         m_sent_v1_header_worth = true;
     }
-    // Wipe the buffer when everything is sent.
+    // Recycle the buffer when everything is sent.
     if (m_send_pos == m_send_buffer.size()) {
         m_send_pos = 0;
-        ClearShrink(m_send_buffer);
+        g_send_buffer_pool.Give(std::move(m_send_buffer));
+        m_send_buffer.clear();
     }
 }
 
+std::span<const uint8_t> V2Transport::GetNextBytesToSend() const noexcept
+{
+    AssertLockNotHeld(m_send_mutex);
+    LOCK(m_send_mutex);
+    if (m_send_state == SendState::V1) return m_v1_fallback.GetNextBytesToSend();
+    return {};
+}
+
 bool V2Transport::ShouldReconnectV1() const noexcept
 {
     AssertLockNotHeld(m_send_mutex);
@@ -1613,7 +1679,11 @@ std::pair<size_t, bool> CConnman::SocketSendData(CNode& node) const
                 ++it;
             }
         }
-        const auto& [data, more, msg_type] = node.m_transport->GetBytesToSend(it != node.vSendMsg.end());
+        const auto& [data, data_more, msg_type] = node.m_transport->GetBytesToSend(it != node.vSendMsg.end());
+        // Bytes that follow data and can be sent along with it, such as a V1 message's payload.
+        const auto next_data{data.empty() ? std::span<const uint8_t>{} : node.m_transport->GetNextBytesToSend()};
+        // After next_data, the transport only has more to send once handed the next message.
+        const bool more{next_data.empty() ? data_more : it != node.vSendMsg.end()};
         // We rely on the 'more' value returned by GetBytesToSend to correctly predict whether more
         // bytes are still to be sent, to correctly set the MSG_MORE flag. As a sanity check,
         // verify that the previously returned 'more' was correct.
@@ -1635,7 +1705,12 @@ std::pair<size_t, bool> CConnman::SocketSendData(CNode& node) const
                 flags |= MSG_MORE;
             }
 #endif
-            nBytes = node.m_sock->Send(data.data(), data.size(), flags);
+            if (next_data.empty()) {
+                nBytes = node.m_sock->Send(data.data(), data.size(), flags);
+            } else {
+                const std::span<const unsigned char> bufs[]{data, next_data};
+                nBytes = node.m_sock->SendV(bufs, flags);
+            }
         }
         if (nBytes > 0) {
             node.m_last_send = GetTime<std::chrono::seconds>();
@@ -1647,7 +1722,7 @@ std::pair<size_t, bool> CConnman::SocketSendData(CNode& node) const
                 node.AccountForSentBytes(msg_type, nBytes);
             }
             nSentSize += nBytes;
-            if ((size_t)nBytes != data.size()) {
+            if ((size_t)nBytes != data.size() + next_data.size()) {
                 // could not send full message; stop sending more
                 break;
             }
@@ -2105,7 +2180,10 @@ void CConnman::SocketHandler()
         // select(2)). If none are ready, wait for a short while and return
         // empty sets.
         events_per_sock = GenerateWaitSockets(snap.Nodes());
-        if (events_per_sock.empty() || !events_per_sock.begin()->first->WaitMany(timeout, events_per_sock)) {
+        const bool waited{m_event_poller ?
+                              m_event_poller->WaitMany(timeout, events_per_sock) :
+                              !events_per_sock.empty() && events_per_sock.begin()->first->WaitMany(timeout, events_per_sock)};
+        if (!waited) {
             m_interrupt_net->sleep_for(timeout);
         }
 
@@ -3497,6 +3575,14 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
 
     fAddressesInitialized = true;
 
+    if (m_use_event_poller) {
+        m_event_poller = std::make_unique<Sock::EventPoller>();
+        if (!m_event_poller->IsAvailable()) {
+            LogWarning("The epoll socket backend is not available, falling back to poll");
+            m_event_poller.reset();
+        }
+    }
+
     if (semOutbound == nullptr) {
         // initialize semaphore
         semOutbound = std::make_unique<std::counting_semaphore<>>(std::min(m_max_automatic_outbound, m_max_automatic_connections));
@@ -3662,6 +3748,8 @@ void CConnman::StopNodes()
     }
     m_nodes_disconnected.clear();
     WITH_LOCK(m_reconnections_mutex, m_reconnections.clear());
+    // Drop the poller's registrations, which keep the sockets open.
+    m_event_poller.reset();
     vhListenSocket.clear();
     semOutbound.reset();
     semAddnode.reset();
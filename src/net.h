@@ -100,6 +100,9 @@ static const size_t DEFAULT_MAXSENDBUFFER    = 1 * 1000;
 
 static constexpr bool DEFAULT_V2_TRANSPORT{true};
 
+/** Whether to wait for socket readiness with the persistent epoll(7) backend */
+static constexpr bool DEFAULT_SOCKET_EVENT_POLLER{false};
+
 typedef int64_t NodeId;
 
 struct AddedNodeParams {
@@ -354,9 +357,19 @@ public:
      */
     virtual BytesToSend GetBytesToSend(bool have_next_message) const noexcept = 0;
 
+    /** Get the bytes that follow the to_send of GetBytesToSend() and are already available, so
+     *  that both can be passed to a single vectored send. For V1Transport, this is the payload of a
+     *  message whose header is being sent.
+     *
+     * If this is not empty, the transport has no more bytes to send after it until it is handed
+     * another message, so the "more" value of GetBytesToSend() does not apply to it.
+     */
+    virtual std::span<const uint8_t> GetNextBytesToSend() const noexcept { return {}; }
+
     /** Report how many bytes returned by the last GetBytesToSend() have been sent.
      *
-     * bytes_sent cannot exceed to_send.size() of the last GetBytesToSend() result.
+     * bytes_sent cannot exceed to_send.size() of the last GetBytesToSend() result, plus the size
+     * of the last GetNextBytesToSend() result.
      *
      * If bytes_sent=0, this call has no effect.
      */
@@ -448,6 +461,7 @@ public:
 
     bool SetMessageToSend(CSerializedNetMsg& msg) noexcept override EXCLUSIVE_LOCKS_REQUIRED(!m_send_mutex);
     BytesToSend GetBytesToSend(bool have_next_message) const noexcept override EXCLUSIVE_LOCKS_REQUIRED(!m_send_mutex);
+    std::span<const uint8_t> GetNextBytesToSend() const noexcept override EXCLUSIVE_LOCKS_REQUIRED(!m_send_mutex);
     void MarkBytesSent(size_t bytes_sent) noexcept override EXCLUSIVE_LOCKS_REQUIRED(!m_send_mutex);
     size_t GetSendMemoryUsage() const noexcept override EXCLUSIVE_LOCKS_REQUIRED(!m_send_mutex);
     bool ShouldReconnectV1() const noexcept override { return false; }
@@ -658,6 +672,7 @@ public:
     // Send side functions.
     bool SetMessageToSend(CSerializedNetMsg& msg) noexcept override EXCLUSIVE_LOCKS_REQUIRED(!m_send_mutex);
     BytesToSend GetBytesToSend(bool have_next_message) const noexcept override EXCLUSIVE_LOCKS_REQUIRED(!m_send_mutex);
+    std::span<const uint8_t> GetNextBytesToSend() const noexcept override EXCLUSIVE_LOCKS_REQUIRED(!m_send_mutex);
     void MarkBytesSent(size_t bytes_sent) noexcept override EXCLUSIVE_LOCKS_REQUIRED(!m_send_mutex);
     size_t GetSendMemoryUsage() const noexcept override EXCLUSIVE_LOCKS_REQUIRED(!m_send_mutex);
 
@@ -1099,6 +1114,7 @@ public:
         bool whitelist_forcerelay = DEFAULT_WHITELISTFORCERELAY;
         bool whitelist_relay = DEFAULT_WHITELISTRELAY;
         bool m_capture_messages = false;
+        bool m_use_event_poller = DEFAULT_SOCKET_EVENT_POLLER;
     };
 
     void Init(const Options& connOptions) EXCLUSIVE_LOCKS_REQUIRED(!m_added_nodes_mutex, !m_total_bytes_sent_mutex)
@@ -1137,6 +1153,7 @@ public:
         whitelist_forcerelay = connOptions.whitelist_forcerelay;
         whitelist_relay = connOptions.whitelist_relay;
         m_capture_messages = connOptions.m_capture_messages;
+        m_use_event_poller = connOptions.m_use_event_poller;
     }
 
     // test only
@@ -1756,6 +1773,15 @@ private:
      */
     bool m_capture_messages{false};
 
+    /** Whether to use `m_event_poller` instead of `Sock::WaitMany()` in `SocketHandler()`. */
+    bool m_use_event_poller{DEFAULT_SOCKET_EVENT_POLLER};
+
+    /**
+     * Persistent readiness backend, created in `Start()` if `m_use_event_poller` is set and
+     * the platform supports it. Only accessed from `threadSocketHandler`, or after it has stopped.
+     */
+    std::unique_ptr<Sock::EventPoller> m_event_poller;
+
     /**
      * Mutex protecting m_i2p_sam_sessions.
      */
@@ -58,6 +58,7 @@
 #include <uint256.h>
 #include <util/check.h>
 #include <util/strencodings.h>
+#include <util/threadpool.h>
 #include <util/time.h>
 #include <util/trace.h>
 #include <validation.h>
@@ -396,6 +397,10 @@ struct Peer {
     Mutex m_getdata_requests_mutex;
     /** Work queue of items requested by this peer **/
     std::deque<CInv> m_getdata_requests GUARDED_BY(m_getdata_requests_mutex);
+    /** Whether a block is being sent to this peer by a getdata worker **/
+    std::atomic<bool> m_block_send_pending{false};
+    /** Completion of the last block sent to this peer by a getdata worker **/
+    std::future<void> m_block_send GUARDED_BY(m_getdata_requests_mutex);
 
     /** Time of the last getheaders message to this peer */
     NodeClock::time_point m_last_getheaders_timestamp GUARDED_BY(NetEventsInterface::g_msgproc_mutex){};
@@ -794,6 +799,9 @@ private:
 
     const Options m_opts;
 
+    /** Single threaded workers serving blocks from disk, see -getdatathreads. Peers are sharded by NodeId. */
+    std::vector<std::unique_ptr<ThreadPool>> m_getdata_workers;
+
     bool RejectIncomingTxs(const CNode& peer) const;
 
     /** Whether we've completed initial sync yet, for determining when to turn
@@ -1022,9 +1030,38 @@ private:
      */
     bool BlockRequestAllowed(const CBlockIndex& block_index) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     bool AlreadyHaveBlock(const uint256& block_hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
-    void ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv& inv)
+    /** A block request to be served from disk by a getdata worker, see ProcessGetBlockData(). */
+    struct DeferredBlockSend {
+        CInv inv;
+        const CBlockIndex* index;
+        const CBlockIndex* tip;
+        FlatFilePos pos;
+    };
+
+    /**
+     * Serve a block requested by the peer. If `allow_deferred` is set and the block must be
+     * read from disk as MSG_BLOCK or MSG_WITNESS_BLOCK, it is not sent but returned, to be
+     * sent by ScheduleBlockSend().
+     */
+    std::optional<DeferredBlockSend> ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv& inv, bool allow_deferred)
         EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex, !m_most_recent_block_mutex);
 
+    /** Read a block requested as MSG_BLOCK or MSG_WITNESS_BLOCK from disk and send it. */
+    void SendBlockFromDisk(CNode& pfrom, const CInv& inv, const CBlockIndex& index, const FlatFilePos& pos)
+        LOCKS_EXCLUDED(::cs_main);
+    /** Log and disconnect the peer after a block it requested could not be read from disk. */
+    void BlockReadFailed(CNode& pfrom, const CBlockIndex& index) LOCKS_EXCLUDED(::cs_main);
+    /** Trigger the peer to send a getblocks request for the next batch of inventory, if inv was its last block. */
+    void MaybeSendContinuationInv(CNode& pfrom, Peer& peer, const CInv& inv, const CBlockIndex& tip)
+        EXCLUSIVE_LOCKS_REQUIRED(!peer.m_block_inv_mutex);
+
+    /**
+     * Send a deferred block, followed by the continuation inv and then not_found, on the
+     * peer's getdata worker. The peer's messages are not processed until it is sent.
+     */
+    void ScheduleBlockSend(CNode& pfrom, Peer& peer, DeferredBlockSend send, std::vector<CInv> not_found)
+        EXCLUSIVE_LOCKS_REQUIRED(peer.m_getdata_requests_mutex);
+
     /**
      * Validation logic for compact filters request handling.
      *
@@ -1676,6 +1713,12 @@ void PeerManagerImpl::ReattemptPrivateBroadcast(CScheduler& scheduler)
 void PeerManagerImpl::FinalizeNode(const CNode& node)
 {
     NodeId nodeid = node.GetId();
+    // A getdata worker may still be sending to the node if it is finalized at shutdown.
+    // It may need cs_main, so wait for it before taking the lock.
+    if (PeerRef peer{GetPeerRef(nodeid)}) {
+        LOCK(peer->m_getdata_requests_mutex);
+        if (peer->m_block_send.valid()) peer->m_block_send.wait();
+    }
     {
     LOCK(cs_main);
     {
@@ -2022,6 +2065,10 @@ PeerManagerImpl::PeerManagerImpl(CConnman& connman, AddrMan& addrman,
     if (opts.reconcile_txs) {
         m_txreconciliation = std::make_unique<TxReconciliationTracker>(TXRECONCILIATION_VERSION);
     }
+    for (int i{0}; i < opts.getdata_threads; ++i) {
+        m_getdata_workers.push_back(std::make_unique<ThreadPool>(strprintf("getdata%d", i)));
+        m_getdata_workers.back()->Start(1);
+    }
 }
 
 void PeerManagerImpl::StartScheduledTasks(CScheduler& scheduler)
@@ -2325,7 +2372,82 @@ void PeerManagerImpl::RelayAddress(NodeId originator,
     }
 }
 
-void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv& inv)
+void PeerManagerImpl::BlockReadFailed(CNode& pfrom, const CBlockIndex& index)
+{
+    if (WITH_LOCK(m_chainman.GetMutex(), return m_chainman.m_blockman.IsBlockPruned(index))) {
+        LogDebug(BCLog::NET, "Block was pruned before it could be read, %s\n", pfrom.DisconnectMsg(fLogIPs));
+    } else {
+        LogError("Cannot load block from disk, %s\n", pfrom.DisconnectMsg(fLogIPs));
+    }
+    pfrom.fDisconnect = true;
+}
+
+void PeerManagerImpl::SendBlockFromDisk(CNode& pfrom, const CInv& inv, const CBlockIndex& index, const FlatFilePos& pos)
+{
+    if (inv.IsMsgWitnessBlk()) {
+        if (const auto block_data{m_chainman.m_blockman.ReadRawBlockData(pos)}) {
+            MakeAndPushMessage(pfrom, NetMsgType::BLOCK, *block_data);
+        } else {
+            BlockReadFailed(pfrom, index);
+        }
+        return;
+    }
+    Assume(inv.IsMsgBlk());
+    CBlock block;
+    if (!m_chainman.m_blockman.ReadBlock(block, pos, inv.hash)) {
+        BlockReadFailed(pfrom, index);
+        return;
+    }
+    MakeAndPushMessage(pfrom, NetMsgType::BLOCK, TX_NO_WITNESS(block));
+}
+
+void PeerManagerImpl::MaybeSendContinuationInv(CNode& pfrom, Peer& peer, const CInv& inv, const CBlockIndex& tip)
+{
+    LOCK(peer.m_block_inv_mutex);
+    // Trigger the peer node to send a getblocks request for the next batch of inventory
+    if (inv.hash == peer.m_continuation_block) {
+        // Send immediately. This must send even if redundant,
+        // and we want it right after the last block so they don't
+        // wait for other stuff first.
+        std::vector<CInv> vInv;
+        vInv.emplace_back(MSG_BLOCK, tip.GetBlockHash());
+        MakeAndPushMessage(pfrom, NetMsgType::INV, vInv);
+        peer.m_continuation_block.SetNull();
+    }
+}
+
+void PeerManagerImpl::ScheduleBlockSend(CNode& pfrom, Peer& peer, DeferredBlockSend send, std::vector<CInv> not_found)
+{
+    PeerRef peer_ref{GetPeerRef(pfrom.GetId())};
+    Assume(peer_ref.get() == &peer);
+    // Keep the node from being deleted by CConnman::DisconnectNodes() while it is served.
+    pfrom.AddRef();
+    peer.m_block_send_pending = true;
+    auto task{[this, &pfrom, peer_ref, send, not_found = std::move(not_found)] {
+        try {
+            SendBlockFromDisk(pfrom, send.inv, *send.index, send.pos);
+            MaybeSendContinuationInv(pfrom, *peer_ref, send.inv, *send.tip);
+            if (!not_found.empty()) MakeAndPushMessage(pfrom, NetMsgType::NOTFOUND, not_found);
+        } catch (const std::exception& e) {
+            LogError("Failed to send block %s, %s: %s\n", send.inv.hash.ToString(), pfrom.DisconnectMsg(fLogIPs), e.what());
+            pfrom.fDisconnect = true;
+        }
+        // Resume processing the peer's messages.
+        peer_ref->m_block_send_pending = false;
+        pfrom.Release();
+        m_connman.WakeMessageHandler();
+    }};
+    ThreadPool& worker{*m_getdata_workers[pfrom.GetId() % m_getdata_workers.size()]};
+    if (auto future{worker.Submit(std::move(task))}) {
+        peer.m_block_send = std::move(*future);
+    } else {
+        // The worker is stopping, so the node is shutting down as well.
+        peer.m_block_send_pending = false;
+        pfrom.Release();
+    }
+}
+
+std::optional<PeerManagerImpl::DeferredBlockSend> PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv& inv, bool allow_deferred)
 {
     std::shared_ptr<const CBlock> a_recent_block;
     std::shared_ptr<const CBlockHeaderAndShortTxIDs> a_recent_compact_block;
@@ -2366,11 +2488,11 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
         LOCK(cs_main);
         pindex = m_chainman.m_blockman.LookupBlockIndex(inv.hash);
         if (!pindex) {
-            return;
+            return std::nullopt;
         }
         if (!BlockRequestAllowed(*pindex)) {
             LogDebug(BCLog::NET, "%s: ignoring request from peer=%i for old block that isn't in the main chain\n", __func__, pfrom.GetId());
-            return;
+            return std::nullopt;
         }
         // disconnect node in case we have reached the outbound limit for serving historical blocks
         if (m_connman.OutboundTargetReached(true) &&
@@ -2379,7 +2501,7 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
         ) {
             LogDebug(BCLog::NET, "historical block serving limit reached, %s\n", pfrom.DisconnectMsg(fLogIPs));
             pfrom.fDisconnect = true;
-            return;
+            return std::nullopt;
         }
         tip = m_chainman.ActiveChain().Tip();
         // Avoid leaking prune-height by never sending blocks below the NODE_NETWORK_LIMITED threshold
@@ -2389,46 +2511,42 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
             LogDebug(BCLog::NET, "Ignore block request below NODE_NETWORK_LIMITED threshold, %s\n", pfrom.DisconnectMsg(fLogIPs));
             //disconnect node and prevent it from stalling (would otherwise wait for the missing block)
             pfrom.fDisconnect = true;
-            return;
+            return std::nullopt;
         }
         // Pruned nodes may have deleted the block, so check whether
         // it's available before trying to send.
         if (!(pindex->nStatus & BLOCK_HAVE_DATA)) {
-            return;
+            return std::nullopt;
         }
         can_direct_fetch = CanDirectFetch();
         block_pos = pindex->GetBlockPos();
     }
 
+    if (allow_deferred && (inv.IsMsgBlk() || inv.IsMsgWitnessBlk()) &&
+        !(a_recent_block && a_recent_block->GetHash() == inv.hash)) {
+        // Leave reading the block from disk and sending it to a getdata worker.
+        return DeferredBlockSend{inv, pindex, tip, block_pos};
+    }
+
     std::shared_ptr<const CBlock> pblock;
     if (a_recent_block && a_recent_block->GetHash() == inv.hash) {
         pblock = a_recent_block;
     } else if (inv.IsMsgWitnessBlk()) {
         // Fast-path: in this case it is possible to serve the block directly from disk,
         // as the network format matches the format on disk
-        if (const auto block_data{m_chainman.m_blockman.ReadRawBlock(block_pos)}) {
-            MakeAndPushMessage(pfrom, NetMsgType::BLOCK, std::span{*block_data});
+        if (const auto block_data{m_chainman.m_blockman.ReadRawBlockData(block_pos)}) {
+            MakeAndPushMessage(pfrom, NetMsgType::BLOCK, *block_data);
         } else {
-            if (WITH_LOCK(m_chainman.GetMutex(), return m_chainman.m_blockman.IsBlockPruned(*pindex))) {
-                LogDebug(BCLog::NET, "Block was pruned before it could be read, %s\n", pfrom.DisconnectMsg(fLogIPs));
-            } else {
-                LogError("Cannot load block from disk, %s\n", pfrom.DisconnectMsg(fLogIPs));
-            }
-            pfrom.fDisconnect = true;
-            return;
+            BlockReadFailed(pfrom, *pindex);
+            return std::nullopt;
         }
         // Don't set pblock as we've sent the block
     } else {
         // Send block from disk
         std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
         if (!m_chainman.m_blockman.ReadBlock(*pblockRead, block_pos, inv.hash)) {
-            if (WITH_LOCK(m_chainman.GetMutex(), return m_chainman.m_blockman.IsBlockPruned(*pindex))) {
-                LogDebug(BCLog::NET, "Block was pruned before it could be read, %s\n", pfrom.DisconnectMsg(fLogIPs));
-            } else {
-                LogError("Cannot load block from disk, %s\n", pfrom.DisconnectMsg(fLogIPs));
-            }
-            pfrom.fDisconnect = true;
-            return;
+            BlockReadFailed(pfrom, *pindex);
+            return std::nullopt;
         }
         pblock = pblockRead;
     }
@@ -2478,19 +2596,8 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
         }
     }
 
-    {
-        LOCK(peer.m_block_inv_mutex);
-        // Trigger the peer node to send a getblocks request for the next batch of inventory
-        if (inv.hash == peer.m_continuation_block) {
-            // Send immediately. This must send even if redundant,
-            // and we want it right after the last block so they don't
-            // wait for other stuff first.
-            std::vector<CInv> vInv;
-            vInv.emplace_back(MSG_BLOCK, tip->GetBlockHash());
-            MakeAndPushMessage(pfrom, NetMsgType::INV, vInv);
-            peer.m_continuation_block.SetNull();
-        }
-    }
+    MaybeSendContinuationInv(pfrom, peer, inv, *tip);
+    return std::nullopt;
 }
 
 CTransactionRef PeerManagerImpl::FindTxForGetData(const Peer::TxRelay& tx_relay, const GenTxid& gtxid)
@@ -2555,10 +2662,11 @@ void PeerManagerImpl::ProcessGetData(CNode& pfrom, Peer& peer, const std::atomic
 
     // Only process one BLOCK item per call, since they're uncommon and can be
     // expensive to process.
+    std::optional<DeferredBlockSend> deferred_send;
     if (it != peer.m_getdata_requests.end() && !pfrom.fPauseSend) {
         const CInv &inv = *it++;
         if (inv.IsGenBlkMsg()) {
-            ProcessGetBlockData(pfrom, peer, inv);
+            deferred_send = ProcessGetBlockData(pfrom, peer, inv, /*allow_deferred=*/!m_getdata_workers.empty());
         }
         // else: If the first item on the queue is an unknown type, we erase it
         // and continue processing the queue on the next call.
@@ -2569,6 +2677,12 @@ void PeerManagerImpl::ProcessGetData(CNode& pfrom, Peer& peer, const std::atomic
 
     peer.m_getdata_requests.erase(peer.m_getdata_requests.begin(), it);
 
+    if (deferred_send) {
+        // The NOTFOUND message is sent after the block, as it would be without a getdata worker.
+        ScheduleBlockSend(pfrom, peer, std::move(*deferred_send), std::move(vNotFound));
+        return;
+    }
+
     if (!vNotFound.empty()) {
         // Let the peer know that we didn't find what it asked for, so it doesn't
         // have to wait around forever.
@@ -5220,6 +5334,10 @@ bool PeerManagerImpl::ProcessMessages(CNode& node, std::atomic<bool>& interruptM
     // has been sent first before processing any incoming messages
     if (!node.IsInboundConn() && !peer.m_outbound_version_message_sent) return false;
 
+    // Wait for a block that is being sent by a getdata worker before processing more
+    // requests or messages from the peer. This maintains the order of responses.
+    if (peer.m_block_send_pending) return false;
+
     {
         LOCK(peer.m_getdata_requests_mutex);
         if (!peer.m_getdata_requests.empty()) {
@@ -5236,6 +5354,7 @@ bool PeerManagerImpl::ProcessMessages(CNode& node, std::atomic<bool>& interruptM
 
     // this maintains the order of responses
     // and prevents m_getdata_requests to grow unbounded
+    if (peer.m_block_send_pending) return false;
     {
         LOCK(peer.m_getdata_requests_mutex);
         if (!peer.m_getdata_requests.empty()) return true;
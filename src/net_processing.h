@@ -43,6 +43,10 @@ static constexpr bool DEFAULT_TXRECONCILIATION_ENABLE{false};
     orphan, replaced, and rejected transactions. */
 static const uint32_t DEFAULT_BLOCK_RECONSTRUCTION_EXTRA_TXN{100};
 static const bool DEFAULT_PEERBLOOMFILTERS = false;
+/** Default number of threads sending blocks requested by peers from disk (0 = the message handler thread) */
+static constexpr int DEFAULT_GETDATA_THREADS{0};
+/** Maximum number of threads sending blocks requested by peers from disk */
+static constexpr int MAX_GETDATA_THREADS{16};
 static const bool DEFAULT_PEERBLOCKFILTERS = false;
 /** Maximum number of outstanding CMPCTBLOCK requests for the same block. */
 static const unsigned int MAX_CMPCTBLOCKS_INFLIGHT_PER_BLOCK = 3;
@@ -94,6 +98,9 @@ public:
         uint32_t max_headers_result{MAX_HEADERS_RESULTS};
         //! Whether private broadcast is used for sending transactions.
         bool private_broadcast{DEFAULT_PRIVATE_BROADCAST};
+        //! Number of threads reading and sending blocks requested by peers. Each peer
+        //! is served by the same thread, selected by its NodeId.
+        int getdata_threads{DEFAULT_GETDATA_THREADS};
     };
 
     static std::unique_ptr<PeerManager> make(CConnman& connman, AddrMan& addrman,
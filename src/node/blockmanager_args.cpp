@@ -8,16 +8,28 @@
 #include <node/blockstorage.h>
 #include <node/database_args.h>
 #include <tinyformat.h>
+#include <util/overflow.h>
 #include <util/result.h>
 #include <util/translation.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <cstdint>
 
 namespace node {
 util::Result<void> ApplyArgsManOptions(const ArgsManager& args, BlockManager::Options& opts)
 {
     if (auto value{args.GetBoolArg("-blocksxor")}) opts.use_xor = *value;
+    if (auto value{args.GetBoolArg("-blocksmmap")}) opts.use_mmap = *value;
+    if (auto value{args.GetBoolArg("-asyncblockwrites")}) opts.async_writes = *value;
+    if (auto value{args.GetBoolArg("-asyncprune")}) opts.async_prune = *value;
+    if (auto value{args.GetBoolArg("-blocksdropcache")}) opts.drop_cache = *value;
+    if (auto value{args.GetIntArg("-blockreadcache")}) {
+        opts.block_cache_bytes = SaturatingLeftShift<uint64_t>(std::max<int64_t>(*value, 0), 20);
+    }
+    if (auto value{args.GetIntArg("-blockreadthreads")}) {
+        opts.block_read_threads = std::clamp<int64_t>(*value, 0, kernel::MAX_BLOCK_READ_THREADS);
+    }
     // block pruning; get the amount of disk space (in MiB) to allot for block & undo files
     int64_t nPruneArg{args.GetIntArg("-prune", opts.prune_target)};
     if (nPruneArg < 0) {
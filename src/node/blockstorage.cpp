@@ -6,7 +6,9 @@
 
 #include <arith_uint256.h>
 #include <chain.h>
+#include <compat/compat.h>
 #include <consensus/params.h>
+#include <core_memusage.h>
 #include <crypto/hex_base.h>
 #include <dbwrapper.h>
 #include <flatfile.h>
@@ -16,6 +18,8 @@
 #include <kernel/messagestartchars.h>
 #include <kernel/notifications_interface.h>
 #include <kernel/types.h>
+#include <logging/timer.h>
+#include <memusage.h>
 #include <pow.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
@@ -27,6 +31,7 @@
 #include <tinyformat.h>
 #include <uint256.h>
 #include <undo.h>
+#include <util/byte_units.h>
 #include <util/check.h>
 #include <util/expected.h>
 #include <util/fs.h>
@@ -37,23 +42,37 @@
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
 #include <util/syserror.h>
+#include <util/threadnames.h>
+#include <util/threadpool.h>
 #include <util/time.h>
 #include <util/translation.h>
 #include <validation.h>
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <compare>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdio>
+#include <deque>
 #include <exception>
+#include <future>
 #include <map>
 #include <optional>
 #include <ostream>
+#include <set>
 #include <span>
 #include <stdexcept>
 #include <system_error>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
 
+#ifndef WIN32
+#include <sys/stat.h>
+#endif
+
 namespace kernel {
 static constexpr uint8_t DB_BLOCK_FILES{'f'};
 static constexpr uint8_t DB_BLOCK_INDEX{'b'};
@@ -117,50 +136,92 @@ bool BlockTreeDB::ReadFlag(const std::string& name, bool& fValue)
     return true;
 }
 
-bool BlockTreeDB::LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex, const util::SignalInterrupt& interrupt)
+namespace {
+//! A block index entry read from the block tree database, along with the
+//! results of the checks done before it is inserted into the block index.
+struct DiskBlockIndexEntry {
+    CDiskBlockIndex index;
+    uint256 hash;
+    bool valid_pow{false};
+};
+
+//! Number of block index entries read from the database before they are checked and inserted.
+constexpr size_t LOAD_BLOCK_INDEX_BATCH_SIZE{4096};
+} // namespace
+
+bool BlockTreeDB::LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex, const util::SignalInterrupt& interrupt, int worker_threads_num)
 {
     AssertLockHeld(::cs_main);
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
     pcursor->Seek(std::make_pair(DB_BLOCK_INDEX, uint256()));
 
+    // Entries are read in batches. Hashing the headers and checking their
+    // proof of work is split between this thread and the worker threads, then
+    // the entries are inserted in database order.
+    ThreadPool pool{"loadidx"};
+    if (worker_threads_num > 0) pool.Start(worker_threads_num);
+    std::vector<DiskBlockIndexEntry> batch;
+    batch.reserve(LOAD_BLOCK_INDEX_BATCH_SIZE);
+
+    const auto check_entries{[&consensusParams](std::span<DiskBlockIndexEntry> entries) {
+        for (DiskBlockIndexEntry& entry : entries) {
+            entry.hash = entry.index.ConstructBlockHash();
+            entry.valid_pow = CheckProofOfWork(entry.hash, entry.index.nBits, consensusParams);
+        }
+    }};
+    const auto insert_batch{[&]() EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
+        const size_t chunk_size{(batch.size() + worker_threads_num) / (worker_threads_num + 1)};
+        std::span<DiskBlockIndexEntry> remaining{batch};
+        std::vector<std::future<void>> futures;
+        while (remaining.size() > chunk_size) {
+            futures.push_back(std::move(*Assert(pool.Submit([&check_entries, entries = remaining.first(chunk_size)] { check_entries(entries); }))));
+            remaining = remaining.subspan(chunk_size);
+        }
+        check_entries(remaining);
+        for (auto& future : futures) future.get();
+
+        for (const auto& [diskindex, hash, valid_pow] : batch) {
+            // Construct block index object
+            CBlockIndex* pindexNew = insertBlockIndex(hash);
+            pindexNew->pprev          = insertBlockIndex(diskindex.hashPrev);
+            pindexNew->nHeight        = diskindex.nHeight;
+            pindexNew->nFile          = diskindex.nFile;
+            pindexNew->nDataPos       = diskindex.nDataPos;
+            pindexNew->nUndoPos       = diskindex.nUndoPos;
+            pindexNew->nVersion       = diskindex.nVersion;
+            pindexNew->hashMerkleRoot = diskindex.hashMerkleRoot;
+            pindexNew->nTime          = diskindex.nTime;
+            pindexNew->nBits          = diskindex.nBits;
+            pindexNew->nNonce         = diskindex.nNonce;
+            pindexNew->nStatus        = diskindex.nStatus;
+            pindexNew->nTx            = diskindex.nTx;
+
+            if (!valid_pow) {
+                LogError("LoadBlockIndexGuts: CheckProofOfWork failed: %s\n", pindexNew->ToString());
+                return false;
+            }
+        }
+        batch.clear();
+        return true;
+    }};
+
     // Load m_block_index
     while (pcursor->Valid()) {
         if (interrupt) return false;
         std::pair<uint8_t, uint256> key;
         if (pcursor->GetKey(key) && key.first == DB_BLOCK_INDEX) {
-            CDiskBlockIndex diskindex;
-            if (pcursor->GetValue(diskindex)) {
-                // Construct block index object
-                CBlockIndex* pindexNew = insertBlockIndex(diskindex.ConstructBlockHash());
-                pindexNew->pprev          = insertBlockIndex(diskindex.hashPrev);
-                pindexNew->nHeight        = diskindex.nHeight;
-                pindexNew->nFile          = diskindex.nFile;
-                pindexNew->nDataPos       = diskindex.nDataPos;
-                pindexNew->nUndoPos       = diskindex.nUndoPos;
-                pindexNew->nVersion       = diskindex.nVersion;
-                pindexNew->hashMerkleRoot = diskindex.hashMerkleRoot;
-                pindexNew->nTime          = diskindex.nTime;
-                pindexNew->nBits          = diskindex.nBits;
-                pindexNew->nNonce         = diskindex.nNonce;
-                pindexNew->nStatus        = diskindex.nStatus;
-                pindexNew->nTx            = diskindex.nTx;
-
-                if (!CheckProofOfWork(pindexNew->GetBlockHash(), pindexNew->nBits, consensusParams)) {
-                    LogError("%s: CheckProofOfWork failed: %s\n", __func__, pindexNew->ToString());
-                    return false;
-                }
-
-                pcursor->Next();
-            } else {
+            if (!pcursor->GetValue(batch.emplace_back().index)) {
                 LogError("%s: failed to read value\n", __func__);
                 return false;
             }
+            if (batch.size() == LOAD_BLOCK_INDEX_BATCH_SIZE && !insert_batch()) return false;
+            pcursor->Next();
         } else {
             break;
         }
     }
 
-    return true;
+    return insert_batch();
 }
 
 std::string CBlockFileInfo::ToString() const
@@ -170,6 +231,9 @@ std::string CBlockFileInfo::ToString() const
 } // namespace kernel
 
 namespace node {
+//! Capacity above which the per-thread block read buffer is freed after use.
+//! Typical blocks fit, so their reads still reuse it.
+static constexpr size_t MAX_KEPT_READ_BUFFER{2_MiB};
 
 bool CBlockIndexWorkComparator::operator()(const CBlockIndex* pa, const CBlockIndex* pb) const
 {
@@ -420,10 +484,10 @@ CBlockIndex* BlockManager::InsertBlockIndex(const uint256& hash)
     return pindex;
 }
 
-bool BlockManager::LoadBlockIndex(const std::optional<uint256>& snapshot_blockhash)
+bool BlockManager::LoadBlockIndex(const std::optional<uint256>& snapshot_blockhash, int worker_threads_num)
 {
     if (!m_block_tree_db->LoadBlockIndexGuts(
-            GetConsensus(), [this](const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main) { return this->InsertBlockIndex(hash); }, m_interrupt)) {
+            GetConsensus(), [this](const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main) { return this->InsertBlockIndex(hash); }, m_interrupt, worker_threads_num)) {
         return false;
     }
 
@@ -457,6 +521,10 @@ bool BlockManager::LoadBlockIndex(const std::optional<uint256>& snapshot_blockha
               CBlockIndexHeightOnlyComparator());
 
     CBlockIndex* previous_index{nullptr};
+    // Consecutive blocks mostly share the same target, so its proof is only
+    // recomputed when nBits changes. A zero nBits has no proof.
+    uint32_t last_bits{0};
+    arith_uint256 last_proof{0};
     for (CBlockIndex* pindex : vSortedByHeight) {
         if (m_interrupt) return false;
         if (previous_index && pindex->nHeight > previous_index->nHeight + 1) {
@@ -464,7 +532,11 @@ bool BlockManager::LoadBlockIndex(const std::optional<uint256>& snapshot_blockha
             return false;
         }
         previous_index = pindex;
-        pindex->nChainWork = (pindex->pprev ? pindex->pprev->nChainWork : 0) + GetBlockProof(*pindex);
+        if (pindex->nBits != last_bits) {
+            last_bits = pindex->nBits;
+            last_proof = GetBlockProof(*pindex);
+        }
+        pindex->nChainWork = (pindex->pprev ? pindex->pprev->nChainWork : 0) + last_proof;
         pindex->nTimeMax = (pindex->pprev ? std::max(pindex->pprev->nTimeMax, pindex->nTime) : pindex->nTime);
 
         // We can link the chain of blocks for which we've received transactions at some point, or
@@ -526,9 +598,9 @@ void BlockManager::WriteBlockIndexDB()
     m_block_tree_db->WriteBatchSync(vFiles, max_blockfile, vBlocks);
 }
 
-bool BlockManager::LoadBlockIndexDB(const std::optional<uint256>& snapshot_blockhash)
+bool BlockManager::LoadBlockIndexDB(const std::optional<uint256>& snapshot_blockhash, int worker_threads_num)
 {
-    if (!LoadBlockIndex(snapshot_blockhash)) {
+    if (!LoadBlockIndex(snapshot_blockhash, worker_threads_num)) {
         return false;
     }
     int max_blockfile_num{0};
@@ -694,9 +766,207 @@ CBlockFileInfo* BlockManager::GetBlockFileInfo(size_t n)
     return &m_blockfile_info.at(n);
 }
 
+/**
+ * Background writer for block and undo data (-asyncblockwrites).
+ *
+ * Positions are allocated by the caller as before, which then queues the
+ * serialized record, or a request to flush a file, instead of writing it. Jobs
+ * are executed in the order they were queued. The writer thread takes all
+ * queued jobs at once, writes consecutive records of a file through a single
+ * open file handle, and skips fsyncs made redundant by a later flush of the
+ * same file in the batch.
+ *
+ * Write and flush failures are reported to the notifications as they would be
+ * on the synchronous path, and make WaitForAll() return false.
+ */
+class BlockFileWriter
+{
+public:
+    enum class Kind { BLOCK, UNDO };
+
+    //! Serialized data that may be queued before callers have to wait for the writer.
+    static constexpr size_t MAX_QUEUED_BYTES{64_MiB};
+
+    BlockFileWriter(const FlatFileSeq& block_file_seq, const FlatFileSeq& undo_file_seq, const Obfuscation& obfuscation, kernel::Notifications& notifications)
+        : m_block_file_seq{block_file_seq}, m_undo_file_seq{undo_file_seq}, m_obfuscation{obfuscation}, m_notifications{notifications}
+    {
+        m_writer = std::thread{[this]() {
+            util::ThreadRename("blockwrite");
+            ThreadWriter();
+        }};
+    }
+
+    ~BlockFileWriter()
+    {
+        // The writer drains the queue before it stops, so no queued block is lost.
+        WITH_LOCK(m_mutex, m_request_stop = true);
+        m_cv.notify_all();
+        m_writer.join();
+    }
+
+    //! Queue a serialized record, including its storage header, to be written at pos.
+    void Write(Kind kind, const FlatFilePos& pos, DataStream&& data) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_queued_bytes < MAX_QUEUED_BYTES || m_queue.empty(); });
+        m_queued_bytes += data.size();
+        Enqueue(Job{kind, pos, std::move(data), /*flush=*/false, /*finalize=*/false});
+    }
+
+    //! Queue a flush of the file, which is truncated to pos.nPos if finalize is set.
+    void Flush(Kind kind, const FlatFilePos& pos, bool finalize) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        Enqueue(Job{kind, pos, DataStream{}, /*flush=*/true, finalize});
+    }
+
+    //! Wait until all jobs queued for the file have been executed.
+    void WaitForFile(Kind kind, int file_num) const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return !m_pending.contains({kind, file_num}); });
+    }
+
+    //! Wait until all queued jobs have been executed. Return false if any of them ever failed.
+    bool WaitForAll() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_pending.empty(); });
+        return !m_failed;
+    }
+
+private:
+    using FileKey = std::pair<Kind, int>;
+
+    struct Job {
+        Kind kind;
+        FlatFilePos pos;
+        DataStream data;
+        bool flush;
+        bool finalize;
+
+        FileKey Key() const { return {kind, pos.nFile}; }
+    };
+
+    void Enqueue(Job&& job) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        ++m_pending[job.Key()];
+        m_queue.push_back(std::move(job));
+        m_cv.notify_all();
+    }
+
+    const FlatFileSeq& Seq(Kind kind) const { return kind == Kind::BLOCK ? m_block_file_seq : m_undo_file_seq; }
+
+    void ThreadWriter() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_request_stop || !m_queue.empty(); });
+            if (m_queue.empty()) return;
+            std::vector<Job> batch{std::make_move_iterator(m_queue.begin()), std::make_move_iterator(m_queue.end())};
+            m_queue.clear();
+            m_queued_bytes = 0;
+            m_cv.notify_all();
+            bool success;
+            {
+                REVERSE_LOCK(lock, m_mutex);
+                success = ExecuteBatch(batch);
+            }
+            if (!success) m_failed = true;
+            for (const Job& job : batch) {
+                const auto it{m_pending.find(job.Key())};
+                if (--it->second == 0) m_pending.erase(it);
+            }
+            m_cv.notify_all();
+        }
+    }
+
+    bool ExecuteBatch(std::vector<Job>& batch) const
+    {
+        // Only the last flush of a file needs to sync it. Truncations are
+        // always executed in order, as records may be appended after them.
+        std::vector<bool> skip_flush(batch.size());
+        std::set<FileKey> flushed;
+        for (size_t i{batch.size()}; i-- > 0;) {
+            if (!batch[i].flush) continue;
+            skip_flush[i] = !batch[i].finalize && flushed.contains(batch[i].Key());
+            flushed.insert(batch[i].Key());
+        }
+
+        bool success{true};
+        std::optional<AutoFile> file;
+        std::optional<FileKey> file_key;
+        const auto write_error{[&](Kind kind) {
+            m_notifications.fatalError(kind == Kind::BLOCK ? _("Failed to write block.") : _("Failed to write undo data."));
+            success = false;
+        }};
+        const auto close_file{[&]() {
+            if (file && file->fclose() != 0) {
+                LogError("Failed to close %s file %05i: %s", file_key->first == Kind::BLOCK ? "block" : "undo", file_key->second, SysErrorString(errno));
+                write_error(file_key->first);
+            }
+            file.reset();
+            file_key.reset();
+        }};
+
+        for (size_t i{0}; i < batch.size(); ++i) {
+            Job& job{batch[i]};
+            if (job.flush) {
+                if (skip_flush[i]) continue;
+                if (file_key == job.Key()) close_file();
+                if (!Seq(job.kind).Flush(job.pos, job.finalize)) {
+                    m_notifications.flushError(job.kind == Kind::BLOCK ?
+                        _("Flushing block file to disk failed. This is likely the result of an I/O error.") :
+                        _("Flushing undo file to disk failed. This is likely the result of an I/O error."));
+                    success = false;
+                }
+                continue;
+            }
+            try {
+                if (file_key != job.Key() || file->tell() != job.pos.nPos) {
+                    close_file();
+                    file.emplace(Seq(job.kind).Open(job.pos, /*read_only=*/false), m_obfuscation);
+                    if (file->IsNull()) {
+                        LogError("Failed to open %s for writing", job.pos.ToString());
+                        file.reset();
+                        write_error(job.kind);
+                        continue;
+                    }
+                    file_key = job.Key();
+                }
+                file->write_buffer(std::span{job.data.data(), job.data.size()});
+            } catch (const std::exception& e) {
+                LogError("Failed to write %s: %s", job.pos.ToString(), e.what());
+                close_file();
+                write_error(job.kind);
+            }
+            job.data = DataStream{};
+        }
+        close_file();
+        return success;
+    }
+
+    const FlatFileSeq& m_block_file_seq;
+    const FlatFileSeq& m_undo_file_seq;
+    const Obfuscation m_obfuscation;
+    kernel::Notifications& m_notifications;
+
+    mutable Mutex m_mutex;
+    mutable std::condition_variable m_cv;
+    std::deque<Job> m_queue GUARDED_BY(m_mutex);
+    //! Size of the records in m_queue.
+    size_t m_queued_bytes GUARDED_BY(m_mutex){0};
+    //! Number of queued or executing jobs per file.
+    std::map<FileKey, size_t> m_pending GUARDED_BY(m_mutex);
+    bool m_failed GUARDED_BY(m_mutex){false};
+    bool m_request_stop GUARDED_BY(m_mutex){false};
+    std::thread m_writer;
+};
+
 bool BlockManager::ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index) const
 {
     const FlatFilePos pos{WITH_LOCK(::cs_main, return index.GetUndoPos())};
+    if (m_block_writer) m_block_writer->WaitForFile(BlockFileWriter::Kind::UNDO, pos.nFile);
 
     // Open history file to read
     AutoFile file{OpenUndoFile(pos, true)};
@@ -732,6 +1002,10 @@ bool BlockManager::ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index
 bool BlockManager::FlushUndoFile(int block_file, bool finalize)
 {
     FlatFilePos undo_pos_old(block_file, m_blockfile_info[block_file].nUndoSize);
+    if (m_block_writer) {
+        m_block_writer->Flush(BlockFileWriter::Kind::UNDO, undo_pos_old, finalize);
+        return true;
+    }
     if (!m_undo_file_seq.Flush(undo_pos_old, finalize)) {
         m_opts.notifications.flushError(_("Flushing undo file to disk failed. This is likely the result of an I/O error."));
         return false;
@@ -754,7 +1028,9 @@ bool BlockManager::FlushBlockFile(int blockfile_num, bool fFinalize, bool finali
     assert(static_cast<int>(m_blockfile_info.size()) > blockfile_num);
 
     FlatFilePos block_pos_old(blockfile_num, m_blockfile_info[blockfile_num].nSize);
-    if (!m_block_file_seq.Flush(block_pos_old, fFinalize)) {
+    if (m_block_writer) {
+        m_block_writer->Flush(BlockFileWriter::Kind::BLOCK, block_pos_old, fFinalize);
+    } else if (!m_block_file_seq.Flush(block_pos_old, fFinalize)) {
         m_opts.notifications.flushError(_("Flushing block file to disk failed. This is likely the result of an I/O error."));
         success = false;
     }
@@ -768,6 +1044,24 @@ bool BlockManager::FlushBlockFile(int blockfile_num, bool fFinalize, bool finali
     return success;
 }
 
+void BlockManager::DropBlockFileCaches(int tip_height)
+{
+    if (!m_opts.drop_cache) return;
+    LOCK(cs_LastBlockFile);
+    for (auto it{m_drop_cache_files.begin()}; it != m_drop_cache_files.end();) {
+        const CBlockFileInfo& info{m_blockfile_info[*it]};
+        // Blocks above the tip were stored ahead of being connected, and are
+        // about to be read again.
+        if (tip_height < 0 || info.nHeightLast > static_cast<unsigned int>(tip_height)) {
+            ++it;
+            continue;
+        }
+        // Pruned files are gone already.
+        if (info.nSize > 0) m_block_file_seq.DropCache(FlatFilePos(*it, 0));
+        it = m_drop_cache_files.erase(it);
+    }
+}
+
 BlockfileType BlockManager::BlockfileTypeForHeight(int height)
 {
     if (!m_snapshot_height) {
@@ -803,8 +1097,12 @@ uint64_t BlockManager::CalculateCurrentUsage()
 
 void BlockManager::UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const
 {
+    // A queued write would recreate the file after it is removed.
+    if (m_block_writer) m_block_writer->WaitForAll();
     std::error_code ec;
     for (std::set<int>::iterator it = setFilesToPrune.begin(); it != setFilesToPrune.end(); ++it) {
+        // Readers holding a view into the mapping keep it alive until they are done.
+        WITH_LOCK(m_mapped_files_mutex, m_mapped_files.erase(*it));
         FlatFilePos pos(*it, 0);
         const bool removed_blockfile{fs::remove(m_block_file_seq.FileName(pos), ec)};
         const bool removed_undofile{fs::remove(m_undo_file_seq.FileName(pos), ec)};
@@ -814,6 +1112,20 @@ void BlockManager::UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const
     }
 }
 
+void BlockManager::ScheduleUnlinkPrunedFiles(std::set<int> files) const
+{
+    if (!m_opts.async_prune) return UnlinkPrunedFiles(files);
+    LOCK(m_unlink_mutex);
+    auto unlinked{m_unlink_pool.Submit([this, files = std::move(files)] { UnlinkPrunedFiles(files); })};
+    m_last_unlink = std::move(*Assert(unlinked)).share();
+}
+
+void BlockManager::WaitForPrunedFileUnlinks() const
+{
+    const std::shared_future<void> last{WITH_LOCK(m_unlink_mutex, return m_last_unlink)};
+    if (last.valid()) last.wait();
+}
+
 AutoFile BlockManager::OpenBlockFile(const FlatFilePos& pos, bool fReadOnly) const
 {
     return AutoFile{m_block_file_seq.Open(pos, fReadOnly), m_obfuscation};
@@ -899,6 +1211,7 @@ FlatFilePos BlockManager::FindNextBlockPos(unsigned int nAddSize, unsigned int n
                           "Failed to flush previous block file %05i (finalize=1, finalize_undo=%i) before opening new block file %05i\n",
                           last_blockfile, finalize_undo, nFile);
         }
+        if (m_opts.drop_cache) m_drop_cache_files.insert(last_blockfile);
         // No undo data yet in the new file, so reset our undo-height tracking.
         m_blockfile_cursors[chain_type] = BlockfileCursor{nFile};
     }
@@ -979,32 +1292,43 @@ bool BlockManager::WriteBlockUndo(const CBlockUndo& blockundo, BlockValidationSt
             return false;
         }
 
-        // Open history file to append
-        AutoFile file{OpenUndoFile(pos)};
-        if (file.IsNull()) {
-            LogError("OpenUndoFile failed for %s while writing block undo", pos.ToString());
-            return FatalError(m_opts.notifications, state, _("Failed to write undo data."));
-        }
-        {
-            BufferedWriter fileout{file};
-
-            // Write index header
-            fileout << GetParams().MessageStart() << blockundo_size;
+        if (m_block_writer) {
+            DataStream data;
+            data.reserve(blockundo_size + UNDO_DATA_DISK_OVERHEAD);
+            data << GetParams().MessageStart() << blockundo_size;
+            HashWriter hasher{};
+            hasher << block.pprev->GetBlockHash() << blockundo;
+            data << blockundo << hasher.GetHash();
+            m_block_writer->Write(BlockFileWriter::Kind::UNDO, pos, std::move(data));
             pos.nPos += STORAGE_HEADER_BYTES;
+        } else {
+            // Open history file to append
+            AutoFile file{OpenUndoFile(pos)};
+            if (file.IsNull()) {
+                LogError("OpenUndoFile failed for %s while writing block undo", pos.ToString());
+                return FatalError(m_opts.notifications, state, _("Failed to write undo data."));
+            }
             {
-                // Calculate checksum
-                HashWriter hasher{};
-                hasher << block.pprev->GetBlockHash() << blockundo;
-                // Write undo data & checksum
-                fileout << blockundo << hasher.GetHash();
+                BufferedWriter fileout{file};
+
+                // Write index header
+                fileout << GetParams().MessageStart() << blockundo_size;
+                pos.nPos += STORAGE_HEADER_BYTES;
+                {
+                    // Calculate checksum
+                    HashWriter hasher{};
+                    hasher << block.pprev->GetBlockHash() << blockundo;
+                    // Write undo data & checksum
+                    fileout << blockundo << hasher.GetHash();
+                }
+                // BufferedWriter will flush pending data to file when fileout goes out of scope.
             }
-            // BufferedWriter will flush pending data to file when fileout goes out of scope.
-        }
 
-        // Make sure that the file is closed before we call `FlushUndoFile`.
-        if (file.fclose() != 0) {
-            LogError("Failed to close block undo file %s: %s", pos.ToString(), SysErrorString(errno));
-            return FatalError(m_opts.notifications, state, _("Failed to close block undo file."));
+            // Make sure that the file is closed before we call `FlushUndoFile`.
+            if (file.fclose() != 0) {
+                LogError("Failed to close block undo file %s: %s", pos.ToString(), SysErrorString(errno));
+                return FatalError(m_opts.notifications, state, _("Failed to close block undo file."));
+            }
         }
 
         // rev files are written in block height order, whereas blk files are written as blocks come in (often out of order)
@@ -1033,23 +1357,86 @@ bool BlockManager::WriteBlockUndo(const CBlockUndo& blockundo, BlockValidationSt
     return true;
 }
 
+std::shared_ptr<const CBlock> BlockCache::Get(const uint256& hash)
+{
+    LOCK(m_mutex);
+    const auto it{m_index.find(hash)};
+    if (it == m_index.end()) {
+        ++m_misses;
+        return nullptr;
+    }
+    ++m_hits;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->block;
+}
+
+void BlockCache::Insert(const uint256& hash, std::shared_ptr<const CBlock> block)
+{
+    const size_t usage{RecursiveDynamicUsage(*block) + memusage::MallocUsage(sizeof(EntryList::value_type)) + memusage::MallocUsage(sizeof(decltype(m_index)::value_type))};
+    if (usage > m_max_usage) return;
+    LOCK(m_mutex);
+    if (m_index.contains(hash)) return;
+    m_entries.push_front(Entry{hash, std::move(block), usage});
+    m_index.emplace(hash, m_entries.begin());
+    m_usage += usage;
+    while (m_usage > m_max_usage) {
+        const Entry& last{m_entries.back()};
+        m_usage -= last.usage;
+        m_index.erase(last.hash);
+        m_entries.pop_back();
+    }
+}
+
+BlockCache::Stats BlockCache::GetStats() const
+{
+    LOCK(m_mutex);
+    return {.entries = m_entries.size(), .usage = m_usage, .max_usage = m_max_usage, .hits = m_hits, .misses = m_misses};
+}
+
 bool BlockManager::ReadBlock(CBlock& block, const FlatFilePos& pos, const std::optional<uint256>& expected_hash) const
 {
     block.SetNull();
 
-    // Open history file to read
-    const auto block_data{ReadRawBlock(pos)};
-    if (!block_data) {
-        return false;
+    // A null position is how the block index marks pruned blocks, which must not be served from the cache.
+    const bool use_cache{expected_hash && !pos.IsNull() && m_opts.block_cache_bytes > 0};
+    if (use_cache) {
+        if (const auto cached{m_block_cache.Get(*expected_hash)}) {
+            block = *cached;
+            return true;
+        }
     }
 
-    try {
-        // Read block
-        SpanReader{*block_data} >> TX_WITH_WITNESS(block);
-    } catch (const std::exception& e) {
-        LogError("Deserialize or I/O error - %s at %s while reading block", e.what(), pos.ToString());
-        return false;
-    }
+    // Blocks are read into a buffer that is reused by all reads on this
+    // thread, instead of allocating a new one for every block. It keeps
+    // its capacity, unless that exceeds MAX_KEPT_READ_BUFFER, so a few
+    // large blocks don't pin up to MAX_BLOCK_SERIALIZED_SIZE on every thread
+    // that ever read one.
+    thread_local std::vector<std::byte> buffer;
+    const bool deserialized{[&] {
+        std::optional<RawBlockData> mapped_data;
+        std::span<const std::byte> block_data;
+        if (m_opts.use_mmap) {
+            auto res{ReadRawBlockData(pos)};
+            if (!res) return false;
+            mapped_data = std::move(*res);
+            block_data = mapped_data->Data(buffer);
+        } else {
+            if (!ReadRawBlock(pos, std::nullopt, buffer)) return false;
+            block_data = buffer;
+        }
+
+        try {
+            // Read block
+            SpanReader{block_data} >> TX_WITH_WITNESS(block);
+        } catch (const std::exception& e) {
+            LogError("Deserialize or I/O error - %s at %s while reading block", e.what(), pos.ToString());
+            return false;
+        }
+        return true;
+    }()};
+    // Also after a failed read, which may have grown the buffer just as much.
+    if (buffer.capacity() > MAX_KEPT_READ_BUFFER) buffer = {};
+    if (!deserialized) return false;
 
     const auto block_hash{block.GetHash()};
 
@@ -1071,6 +1458,8 @@ bool BlockManager::ReadBlock(CBlock& block, const FlatFilePos& pos, const std::o
         return false;
     }
 
+    if (use_cache) m_block_cache.Insert(block_hash, std::make_shared<const CBlock>(block));
+
     return true;
 }
 
@@ -1080,7 +1469,148 @@ bool BlockManager::ReadBlock(CBlock& block, const CBlockIndex& index) const
     return ReadBlock(block, block_pos, index.GetBlockHash());
 }
 
+/** Read-only memory mapping of a whole file. */
+class MappedFile
+{
+public:
+    //! Map the file at `path`, or return nullptr if it is empty or cannot be mapped.
+    static std::shared_ptr<const MappedFile> Open(const fs::path& path)
+    {
+#ifdef WIN32
+        return nullptr;
+#else
+        const int fd{open(fs::PathToString(path).c_str(), O_RDONLY)};
+        if (fd == -1) return nullptr;
+        struct stat st;
+        void* addr{MAP_FAILED};
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (addr == MAP_FAILED) {
+            LogDebug(BCLog::BLOCKSTORAGE, "Unable to map %s: %s", fs::PathToString(path), SysErrorString(errno));
+            return nullptr;
+        }
+        return std::shared_ptr<const MappedFile>{new MappedFile{static_cast<const std::byte*>(addr), size_t(st.st_size)}};
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef WIN32
+        munmap(const_cast<std::byte*>(m_data.data()), m_data.size());
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::span<const std::byte> Data() const { return m_data; }
+
+private:
+    explicit MappedFile(const std::byte* data, size_t size) : m_data{data, size} {}
+
+    const std::span<const std::byte> m_data;
+};
+
+RawBlockData::RawBlockData(std::vector<std::byte> data)
+    : m_owned{std::move(data)}, m_data{m_owned} {}
+
+RawBlockData::RawBlockData(std::shared_ptr<const MappedFile> mapping, std::span<const std::byte> data, size_t file_offset, const Obfuscation& obfuscation)
+    : m_mapping{std::move(mapping)}, m_data{data}, m_file_offset{file_offset}, m_obfuscation{obfuscation} {}
+
+std::span<const std::byte> RawBlockData::Data(std::vector<std::byte>& buffer) const
+{
+    if (!m_obfuscation) return m_data;
+    buffer.assign(m_data.begin(), m_data.end());
+    m_obfuscation(buffer, m_file_offset);
+    return buffer;
+}
+
+std::shared_ptr<const MappedFile> BlockManager::GetMappedBlockFile(int file_num) const
+{
+    {
+        LOCK(m_mapped_files_mutex);
+        if (const auto it{m_mapped_files.find(file_num)}; it != m_mapped_files.end()) {
+            it->second.last_used = ++m_mapped_files_clock;
+            return it->second.mapping;
+        }
+    }
+    {
+        // Files that are still written to may grow, or shrink when they are
+        // finalized, which would invalidate the mapping. Finalized files are
+        // never written to again.
+        // Cursors are only ever moved to new files after MaxBlockfileNum().
+        LOCK(cs_LastBlockFile);
+        if (file_num < 0 || file_num > MaxBlockfileNum()) return nullptr;
+        for (const auto& cursor : m_blockfile_cursors) {
+            if (cursor && cursor->file_num == file_num) return nullptr;
+        }
+    }
+    // The last writes and the truncation of the file may still be queued.
+    if (m_block_writer) m_block_writer->WaitForFile(BlockFileWriter::Kind::BLOCK, file_num);
+    auto mapping{MappedFile::Open(m_block_file_seq.FileName({file_num, 0}))};
+    if (!mapping) return nullptr;
+    LOCK(m_mapped_files_mutex);
+    if (m_mapped_files.size() >= MAX_MAPPED_BLOCKFILES && !m_mapped_files.contains(file_num)) {
+        m_mapped_files.erase(std::ranges::min_element(m_mapped_files, {}, [](const auto& entry) { return entry.second.last_used; }));
+    }
+    auto& entry{m_mapped_files.try_emplace(file_num, std::move(mapping), 0).first->second};
+    entry.last_used = ++m_mapped_files_clock;
+    return entry.mapping;
+}
+
+BlockManager::ReadRawBlockDataResult BlockManager::ReadRawBlockData(const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part) const
+{
+    if (m_opts.use_mmap && pos.nPos >= STORAGE_HEADER_BYTES) {
+        if (auto mapping{GetMappedBlockFile(pos.nFile)}) {
+            const auto file{mapping->Data()};
+            if (pos.nPos > file.size()) {
+                LogError("Block position %s is beyond the end of the block file while reading raw block", pos.ToString());
+                return util::Unexpected{ReadRawError::IO};
+            }
+            std::array<std::byte, STORAGE_HEADER_BYTES> header;
+            std::ranges::copy(file.subspan(pos.nPos - STORAGE_HEADER_BYTES, STORAGE_HEADER_BYTES), header.begin());
+            m_obfuscation(header, pos.nPos - STORAGE_HEADER_BYTES);
+            MessageStartChars blk_start;
+            unsigned int blk_size;
+            SpanReader{header} >> blk_start >> blk_size;
+
+            if (blk_start != GetParams().MessageStart()) {
+                LogError("Block magic mismatch for %s: %s versus expected %s while reading raw block",
+                    pos.ToString(), HexStr(blk_start), HexStr(GetParams().MessageStart()));
+                return util::Unexpected{ReadRawError::IO};
+            }
+            if (blk_size > MAX_SIZE || pos.nPos + blk_size > file.size()) {
+                LogError("Block data size %s is invalid for %s while reading raw block", blk_size, pos.ToString());
+                return util::Unexpected{ReadRawError::IO};
+            }
+
+            size_t offset{0};
+            size_t size{blk_size};
+            if (block_part) {
+                std::tie(offset, size) = *block_part;
+                if (size == 0 || SaturatingAdd(offset, size) > blk_size) {
+                    return util::Unexpected{ReadRawError::BadPartRange}; // Avoid logging - offset/size come from untrusted REST input
+                }
+            }
+            return RawBlockData{std::move(mapping), file.subspan(pos.nPos + offset, size), pos.nPos + offset, m_obfuscation};
+        }
+    }
+
+    auto data{ReadRawBlock(pos, block_part)};
+    if (!data) return util::Unexpected{data.error()};
+    return RawBlockData{std::move(*data)};
+}
+
 BlockManager::ReadRawBlockResult BlockManager::ReadRawBlock(const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part) const
+{
+    std::vector<std::byte> data;
+    if (auto res{ReadRawBlock(pos, block_part, data)}; !res) return util::Unexpected{res.error()};
+    return data;
+}
+
+util::Expected<void, ReadRawError> BlockManager::ReadRawBlock(const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part, std::vector<std::byte>& data) const
 {
     if (pos.nPos < STORAGE_HEADER_BYTES) {
         // If nPos is less than STORAGE_HEADER_BYTES, we can't read the header that precedes the block data
@@ -1089,6 +1619,7 @@ BlockManager::ReadRawBlockResult BlockManager::ReadRawBlock(const FlatFilePos& p
         LogError("Failed for %s while reading raw block storage header", pos.ToString());
         return util::Unexpected{ReadRawError::IO};
     }
+    if (m_block_writer) m_block_writer->WaitForFile(BlockFileWriter::Kind::BLOCK, pos.nFile);
     AutoFile filein{OpenBlockFile({pos.nFile, pos.nPos - STORAGE_HEADER_BYTES}, /*fReadOnly=*/true)};
     if (filein.IsNull()) {
         LogError("OpenBlockFile failed for %s while reading raw block", pos.ToString());
@@ -1122,15 +1653,37 @@ BlockManager::ReadRawBlockResult BlockManager::ReadRawBlock(const FlatFilePos& p
             blk_size = size;
         }
 
-        std::vector<std::byte> data(blk_size); // Zeroing of memory is intentional here
+        // A reused buffer is only zeroed where it grows. Either way, every
+        // byte is overwritten by the read, or the read throws.
+        data.resize(blk_size);
         filein.read(data);
-        return data;
+        return {};
     } catch (const std::exception& e) {
         LogError("Read from block file failed: %s for %s while reading raw block", e.what(), pos.ToString());
         return util::Unexpected{ReadRawError::IO};
     }
 }
 
+std::vector<BlockManager::ReadRawBlockResult> BlockManager::ReadRawBlocks(std::span<const FlatFilePos> positions) const
+{
+    std::vector<std::future<ReadRawBlockResult>> futures;
+    if (m_opts.block_read_threads > 0) {
+        futures.reserve(positions.size());
+        for (const FlatFilePos& pos : positions) {
+            futures.push_back(std::move(*Assert(m_read_pool.Submit([this, pos] { return ReadRawBlock(pos); }))));
+        }
+        // Help with the reads instead of waiting idle.
+        while (m_read_pool.ProcessTask()) {}
+    }
+
+    std::vector<ReadRawBlockResult> results;
+    results.reserve(positions.size());
+    for (size_t i{0}; i < positions.size(); ++i) {
+        results.push_back(futures.empty() ? ReadRawBlock(positions[i]) : futures[i].get());
+    }
+    return results;
+}
+
 FlatFilePos BlockManager::WriteBlock(const CBlock& block, int nHeight)
 {
     const unsigned int block_size{static_cast<unsigned int>(GetSerializeSize(TX_WITH_WITNESS(block)))};
@@ -1139,6 +1692,14 @@ FlatFilePos BlockManager::WriteBlock(const CBlock& block, int nHeight)
         LogError("FindNextBlockPos failed for %s while writing block", pos.ToString());
         return FlatFilePos();
     }
+    if (m_block_writer) {
+        DataStream data;
+        data.reserve(block_size + STORAGE_HEADER_BYTES);
+        data << GetParams().MessageStart() << block_size << TX_WITH_WITNESS(block);
+        m_block_writer->Write(BlockFileWriter::Kind::BLOCK, pos, std::move(data));
+        pos.nPos += STORAGE_HEADER_BYTES;
+        return pos;
+    }
     AutoFile file{OpenBlockFile(pos, /*fReadOnly=*/false)};
     if (file.IsNull()) {
         LogError("OpenBlockFile failed for %s while writing block", pos.ToString());
@@ -1227,9 +1788,15 @@ BlockManager::BlockManager(const util::SignalInterrupt& interrupt, Options opts)
       m_opts{std::move(opts)},
       m_block_file_seq{FlatFileSeq{m_opts.blocks_dir, "blk", m_opts.fast_prune ? 0x4000 /* 16kB */ : BLOCKFILE_CHUNK_SIZE}},
       m_undo_file_seq{FlatFileSeq{m_opts.blocks_dir, "rev", UNDOFILE_CHUNK_SIZE}},
+      m_block_cache{m_opts.block_cache_bytes},
       m_interrupt{interrupt}
 {
     m_block_tree_db = std::make_unique<BlockTreeDB>(m_opts.block_tree_db_params);
+    if (m_opts.block_read_threads > 0) m_read_pool.Start(m_opts.block_read_threads);
+    if (m_opts.async_prune) m_unlink_pool.Start(1);
+    if (m_opts.async_writes) {
+        m_block_writer = std::make_unique<BlockFileWriter>(m_block_file_seq, m_undo_file_seq, m_obfuscation, m_opts.notifications);
+    }
 
     if (m_opts.block_tree_db_params.wipe_data) {
         m_block_tree_db->WriteReindexing(true);
@@ -1241,6 +1808,15 @@ BlockManager::BlockManager(const util::SignalInterrupt& interrupt, Options opts)
     }
 }
 
+BlockManager::~BlockManager() = default;
+
+bool BlockManager::WaitForBlockWrites() const
+{
+    if (!m_block_writer) return true;
+    LOG_TIME_MILLIS_WITH_CATEGORY("wait for background block and undo writes", BCLog::BENCH);
+    return m_block_writer->WaitForAll();
+}
+
 class ImportingNow
 {
     std::atomic<bool>& m_importing;
@@ -1262,6 +1838,10 @@ void ImportBlocks(ChainstateManager& chainman, std::span<const fs::path> import_
 {
     ImportingNow imp{chainman.m_blockman.m_importing};
 
+    // Blocks are deserialized ahead on these threads, for all imported files.
+    ThreadPool pool{"loadblk"};
+    if (chainman.m_options.worker_threads_num > 0) pool.Start(chainman.m_options.worker_threads_num);
+
     // -reindex
     if (!chainman.m_blockman.m_blockfiles_indexed) {
         int total_files{0};
@@ -1280,7 +1860,7 @@ void ImportBlocks(ChainstateManager& chainman, std::span<const fs::path> import_
                 break; // This error is logged in OpenBlockFile
             }
             LogInfo("Reindexing block file blk%05u.dat (%d%% complete)...", (unsigned int)nFile, nFile * 100 / total_files);
-            chainman.LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent);
+            chainman.LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent, &pool);
             if (chainman.m_interrupt) {
                 LogInfo("Interrupt requested. Exit reindexing.");
                 return;
@@ -1298,7 +1878,7 @@ void ImportBlocks(ChainstateManager& chainman, std::span<const fs::path> import_
         AutoFile file{fsbridge::fopen(path, "rb")};
         if (!file.IsNull()) {
             LogInfo("Importing blocks file %s...", fs::PathToString(path));
-            chainman.LoadExternalBlockFile(file);
+            chainman.LoadExternalBlockFile(file, /*dbp=*/nullptr, /*blocks_with_unknown_parent=*/nullptr, &pool);
             if (chainman.m_interrupt) {
                 LogInfo("Interrupt requested. Exit block importing.");
                 return;
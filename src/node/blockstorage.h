@@ -16,12 +16,14 @@
 #include <primitives/block.h>
 #include <serialize.h>
 #include <streams.h>
+#include <support/allocators/pool.h>
 #include <sync.h>
 #include <uint256.h>
 #include <util/expected.h>
 #include <util/fs.h>
 #include <util/hasher.h>
 #include <util/obfuscation.h>
+#include <util/threadpool.h>
 
 #include <algorithm>
 #include <array>
@@ -29,8 +31,10 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <iosfwd>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
@@ -106,7 +110,12 @@ public:
     void ReadReindexing(bool& fReindexing);
     void WriteFlag(const std::string& name, bool fValue);
     bool ReadFlag(const std::string& name, bool& fValue);
-    bool LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex, const util::SignalInterrupt& interrupt)
+    /**
+     * Load all block index entries, inserting them with insertBlockIndex.
+     * The entries' hashes and proof of work are checked on worker_threads_num
+     * additional threads, if any.
+     */
+    bool LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex, const util::SignalInterrupt& interrupt, int worker_threads_num = 0)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 };
 } // namespace kernel
@@ -132,7 +141,19 @@ static constexpr uint32_t UNDO_DATA_DISK_OVERHEAD{STORAGE_HEADER_BYTES + uint256
 // we ever switch to another associative container, we need to either use a
 // container that has stable addressing (true of all std associative
 // containers), or make the key a `std::unique_ptr<CBlockIndex>`
-using BlockMap = std::unordered_map<uint256, CBlockIndex, BlockHasher>;
+//
+// Nodes are allocated from a PoolResource owned by the BlockManager, so the
+// entries are packed into large contiguous chunks instead of being allocated
+// individually. See CCoinsMap for the choice of MAX_BLOCK_SIZE_BYTES.
+using BlockMapPair = std::pair<const uint256, CBlockIndex>;
+using BlockMap = std::unordered_map<uint256,
+                                    CBlockIndex,
+                                    BlockHasher,
+                                    std::equal_to<uint256>,
+                                    PoolAllocator<BlockMapPair,
+                                                  sizeof(BlockMapPair) + sizeof(void*) * 4>>;
+
+using BlockMapMemoryResource = BlockMap::allocator_type::ResourceType;
 
 struct CBlockIndexWorkComparator {
     bool operator()(const CBlockIndex* pa, const CBlockIndex* pb) const;
@@ -181,6 +202,100 @@ enum class ReadRawError {
     BadPartRange,
 };
 
+class BlockFileWriter;
+class MappedFile;
+
+/**
+ * Serialized block data returned by BlockManager::ReadRawBlockData().
+ *
+ * Either owns a copy of the data read from the block file, or is a view into
+ * a memory-mapped block file that keeps the mapping alive. A view is still
+ * obfuscated with the block file key, which is removed when the data is
+ * copied out.
+ */
+class RawBlockData
+{
+public:
+    explicit RawBlockData(std::vector<std::byte> data);
+    RawBlockData(std::shared_ptr<const MappedFile> mapping, std::span<const std::byte> data, size_t file_offset, const Obfuscation& obfuscation);
+
+    RawBlockData(RawBlockData&&) = default;
+    RawBlockData& operator=(RawBlockData&&) = default;
+
+    size_t size() const { return m_data.size(); }
+
+    /**
+     * Return the block data. This does not copy unless the data needs to be
+     * deobfuscated, in which case it is written to `buffer`, which the caller
+     * can reuse across calls.
+     */
+    std::span<const std::byte> Data(std::vector<std::byte>& buffer LIFETIMEBOUND) const;
+
+    //! Write the block data to `s`, deobfuscating it through a small stack buffer.
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        if (!m_obfuscation) return s.write(m_data);
+        std::array<std::byte, 4096> buffer;
+        for (size_t pos{0}; pos < m_data.size(); pos += buffer.size()) {
+            const auto part{std::span{buffer}.first(std::min(buffer.size(), m_data.size() - pos))};
+            std::ranges::copy(m_data.subspan(pos, part.size()), part.begin());
+            m_obfuscation(part, m_file_offset + pos);
+            s.write(part);
+        }
+    }
+
+private:
+    std::vector<std::byte> m_owned;
+    std::shared_ptr<const MappedFile> m_mapping;
+    std::span<const std::byte> m_data;
+    //! Position of m_data in the block file, which the obfuscation key is aligned to.
+    size_t m_file_offset{0};
+    Obfuscation m_obfuscation;
+};
+
+/**
+ * Bounded cache of recently read blocks, shared by all readers of the same
+ * block (peers, indexes, wallets, RPC). The least recently used blocks are
+ * evicted once the memory usage of the cached blocks exceeds the limit.
+ */
+class BlockCache
+{
+public:
+    struct Stats {
+        size_t entries{0};
+        size_t usage{0};
+        size_t max_usage{0};
+        uint64_t hits{0};
+        uint64_t misses{0};
+    };
+
+    explicit BlockCache(size_t max_usage) : m_max_usage{max_usage} {}
+
+    //! Return the cached block, or nullptr. Counts a hit or a miss.
+    std::shared_ptr<const CBlock> Get(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    //! Cache the block, unless it alone exceeds the limit.
+    void Insert(const uint256& hash, std::shared_ptr<const CBlock> block) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    Stats GetStats() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    struct Entry {
+        uint256 hash;
+        std::shared_ptr<const CBlock> block;
+        size_t usage;
+    };
+    using EntryList = std::list<Entry>;
+
+    const size_t m_max_usage;
+    mutable Mutex m_mutex;
+    //! Most recently used first.
+    EntryList m_entries GUARDED_BY(m_mutex);
+    std::unordered_map<uint256, EntryList::iterator, BlockHasher> m_index GUARDED_BY(m_mutex);
+    size_t m_usage GUARDED_BY(m_mutex){0};
+    uint64_t m_hits GUARDED_BY(m_mutex){0};
+    uint64_t m_misses GUARDED_BY(m_mutex){0};
+};
+
 /**
  * Maintains a tree of blocks (stored in `m_block_index`) which is consulted
  * to determine where the most-work tip is.
@@ -201,7 +316,7 @@ private:
      * per index entry (nStatus, nChainWork, nTimeMax, etc.) as well as peripheral
      * collections like m_dirty_blockindex.
      */
-    bool LoadBlockIndex(const std::optional<uint256>& snapshot_blockhash)
+    bool LoadBlockIndex(const std::optional<uint256>& snapshot_blockhash, int worker_threads_num)
         EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     /** Return false if block file or undo file flushing fails. */
@@ -221,6 +336,12 @@ private:
      */
     [[nodiscard]] FlatFilePos FindNextBlockPos(unsigned int nAddSize, unsigned int nHeight, uint64_t nTime);
     [[nodiscard]] bool FlushChainstateBlockFile(int tip_height);
+    /**
+     * With -blocksdropcache, evict the finalized block files whose blocks are
+     * all at or below tip_height from the OS page cache. Pending block writes
+     * must have completed.
+     */
+    void DropBlockFileCaches(int tip_height);
     bool FindUndoPos(BlockValidationState& state, int nFile, FlatFilePos& pos, unsigned int nAddSize);
 
     AutoFile OpenUndoFile(const FlatFilePos& pos, bool fReadOnly = false) const;
@@ -253,7 +374,7 @@ private:
         const Chainstate& chain,
         ChainstateManager& chainman);
 
-    RecursiveMutex cs_LastBlockFile;
+    mutable RecursiveMutex cs_LastBlockFile;
 
     //! Since assumedvalid chainstates may be syncing a range of the chain that is very
     //! far away from the normal/background validation process, we should segment blockfiles
@@ -270,6 +391,9 @@ private:
             BlockfileCursor{},
             std::nullopt,
     };
+    //! Finalized block files that -blocksdropcache evicts from the page cache
+    //! once the tip has passed all of their blocks.
+    std::set<int> m_drop_cache_files GUARDED_BY(cs_LastBlockFile);
     int MaxBlockfileNum() const EXCLUSIVE_LOCKS_REQUIRED(cs_LastBlockFile)
     {
         static const BlockfileCursor empty_cursor;
@@ -303,6 +427,39 @@ private:
     const FlatFileSeq m_block_file_seq;
     const FlatFileSeq m_undo_file_seq;
 
+    //! Background writer for block and undo data, if -asyncblockwrites is enabled.
+    std::unique_ptr<BlockFileWriter> m_block_writer;
+
+    //! Maximum number of block files kept memory-mapped for ReadRawBlockData().
+    //! The least recently used mapping is dropped to make room for a new one.
+    static constexpr size_t MAX_MAPPED_BLOCKFILES{64};
+    struct MappedBlockFile {
+        std::shared_ptr<const MappedFile> mapping;
+        //! Value of m_mapped_files_clock when the mapping was last used.
+        uint64_t last_used;
+    };
+    mutable Mutex m_mapped_files_mutex;
+    mutable std::map<int, MappedBlockFile> m_mapped_files GUARDED_BY(m_mapped_files_mutex);
+    mutable uint64_t m_mapped_files_clock GUARDED_BY(m_mapped_files_mutex){0};
+
+    //! Map a finalized block file, or return nullptr if it is still being written to or cannot be mapped.
+    std::shared_ptr<const MappedFile> GetMappedBlockFile(int file_num) const EXCLUSIVE_LOCKS_REQUIRED(!m_mapped_files_mutex);
+
+    //! Blocks returned by ReadBlock() for a known hash, see -blockreadcache.
+    mutable BlockCache m_block_cache;
+
+    //! Read a raw block into data, reusing its capacity. See the public ReadRawBlock().
+    util::Expected<void, ReadRawError> ReadRawBlock(const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part, std::vector<std::byte>& data) const;
+
+    //! Workers for ReadRawBlocks(), started if -blockreadthreads is set.
+    mutable ThreadPool m_read_pool{"blockread"};
+
+    //! Worker deleting pruned files, started if -asyncprune is set.
+    mutable ThreadPool m_unlink_pool{"blockunlink"};
+    mutable Mutex m_unlink_mutex;
+    //! Completion of the most recently queued deletion. Deletions run in order.
+    mutable std::shared_future<void> m_last_unlink GUARDED_BY(m_unlink_mutex);
+
 protected:
     std::vector<CBlockFileInfo> m_blockfile_info;
 
@@ -315,8 +472,10 @@ protected:
 public:
     using Options = kernel::BlockManagerOpts;
     using ReadRawBlockResult = util::Expected<std::vector<std::byte>, ReadRawError>;
+    using ReadRawBlockDataResult = util::Expected<RawBlockData, ReadRawError>;
 
     explicit BlockManager(const util::SignalInterrupt& interrupt, Options opts);
+    ~BlockManager();
 
     const util::SignalInterrupt& m_interrupt;
     std::atomic<bool> m_importing{false};
@@ -329,7 +488,9 @@ public:
      */
     std::atomic_bool m_blockfiles_indexed{true};
 
-    BlockMap m_block_index GUARDED_BY(cs_main);
+    //! Backing memory for the m_block_index nodes. Must outlive m_block_index.
+    BlockMapMemoryResource m_block_index_memory_resource;
+    BlockMap m_block_index GUARDED_BY(cs_main){0, BlockHasher{}, BlockMap::key_equal{}, &m_block_index_memory_resource};
 
     /**
      * The height of the base block of an assumeutxo snapshot, if one is in use.
@@ -356,7 +517,7 @@ public:
     std::unique_ptr<BlockTreeDB> m_block_tree_db GUARDED_BY(::cs_main);
 
     void WriteBlockIndexDB() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
-    bool LoadBlockIndexDB(const std::optional<uint256>& snapshot_blockhash)
+    bool LoadBlockIndexDB(const std::optional<uint256>& snapshot_blockhash, int worker_threads_num = 0)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
     /**
@@ -392,6 +553,15 @@ public:
      */
     FlatFilePos WriteBlock(const CBlock& block, int nHeight);
 
+    /**
+     * Durability barrier for -asyncblockwrites: wait until all block and undo
+     * data and file flushes queued so far have been executed, so the block
+     * index entries referring to them can be written.
+     *
+     * @returns false if a background write or flush failed
+     */
+    [[nodiscard]] bool WaitForBlockWrites() const;
+
     /** Update blockfile info while processing a block during reindex. The block must be available on disk.
      *
      * @param[in]  block        the block being processed
@@ -407,6 +577,9 @@ public:
     [[nodiscard]] uint64_t GetPruneTarget() const { return m_opts.prune_target; }
     static constexpr auto PRUNE_TARGET_MANUAL{std::numeric_limits<uint64_t>::max()};
 
+    /** Number of threads blocks are read on concurrently, 0 if -blockreadthreads is disabled. */
+    [[nodiscard]] int GetBlockReadThreads() const { return m_opts.block_read_threads; }
+
     [[nodiscard]] bool LoadingBlocks() const { return m_importing || !m_blockfiles_indexed; }
 
     /** Calculate the amount of disk space the block & undo files currently use */
@@ -464,15 +637,42 @@ public:
     /**
      *  Actually unlink the specified files
      */
-    void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const;
+    void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const EXCLUSIVE_LOCKS_REQUIRED(!m_mapped_files_mutex);
+
+    /**
+     * Unlink the specified files on a background thread if -asyncprune is
+     * set, or right away otherwise. The files must already be marked as
+     * pruned in the block index.
+     */
+    void ScheduleUnlinkPrunedFiles(std::set<int> files) const EXCLUSIVE_LOCKS_REQUIRED(!m_mapped_files_mutex, !m_unlink_mutex);
+
+    /** Wait until the deletions queued by ScheduleUnlinkPrunedFiles() have completed. */
+    void WaitForPrunedFileUnlinks() const EXCLUSIVE_LOCKS_REQUIRED(!m_unlink_mutex);
 
-    /** Functions for disk access for blocks */
+    /**
+     * Functions for disk access for blocks. Blocks read for a known hash are
+     * served from, and added to, the block cache.
+     */
     bool ReadBlock(CBlock& block, const FlatFilePos& pos, const std::optional<uint256>& expected_hash) const;
     bool ReadBlock(CBlock& block, const CBlockIndex& index) const;
     ReadRawBlockResult ReadRawBlock(const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part = std::nullopt) const;
+    /**
+     * Read a batch of raw blocks, concurrently on the block read threads if
+     * -blockreadthreads is set. The results are in the order of positions.
+     */
+    std::vector<ReadRawBlockResult> ReadRawBlocks(std::span<const FlatFilePos> positions) const;
+    /**
+     * Like ReadRawBlock(), but serve the block from a memory mapping of its
+     * block file if -blocksmmap is enabled and the file is finalized, instead
+     * of copying it into a new buffer.
+     */
+    ReadRawBlockDataResult ReadRawBlockData(const FlatFilePos& pos, std::optional<std::pair<size_t, size_t>> block_part = std::nullopt) const
+        EXCLUSIVE_LOCKS_REQUIRED(!m_mapped_files_mutex);
 
     bool ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index) const;
 
+    BlockCache::Stats GetBlockCacheStats() const { return m_block_cache.GetStats(); }
+
     void CleanupBlockRevFiles() const;
 };
 
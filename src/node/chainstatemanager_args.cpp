@@ -58,6 +58,9 @@ util::Result<void> ApplyArgsManOptions(const ArgsManager& args, ChainstateManage
     }
     // Subtract 1 because the main thread counts towards the par threads.
     opts.worker_threads_num = script_threads - 1;
+    opts.script_check_work_stealing = args.GetBoolArg("-parworkstealing", DEFAULT_SCRIPTCHECK_WORK_STEALING);
+
+    opts.input_fetch_threads_num = std::clamp<int64_t>(args.GetIntArg("-inputfetchthreads", DEFAULT_INPUT_FETCH_THREADS), 0, MAX_INPUT_FETCH_THREADS);
 
     if (auto max_size = args.GetIntArg("-maxsigcachesize")) {
         // 1. When supplied with a max_size of 0, both the signature cache and
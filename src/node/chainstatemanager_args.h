@@ -12,6 +12,10 @@ class ArgsManager;
 
 /** -par default (number of script-checking threads, 0 = auto) */
 static constexpr int DEFAULT_SCRIPTCHECK_THREADS{0};
+/** -parworkstealing default (whether script-checking threads steal work from each other) */
+static constexpr bool DEFAULT_SCRIPTCHECK_WORK_STEALING{false};
+/** -inputfetchthreads default (number of block input prefetching threads, 0 = disabled) */
+static constexpr int DEFAULT_INPUT_FETCH_THREADS{4};
 
 namespace node {
 [[nodiscard]] util::Result<void> ApplyArgsManOptions(const ArgsManager& args, ChainstateManager::Options& opts);
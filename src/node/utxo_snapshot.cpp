@@ -4,22 +4,367 @@
 
 #include <node/utxo_snapshot.h>
 
+#include <consensus/amount.h>
+#include <hash.h>
+#include <kernel/coinstats.h>
+#include <serialize.h>
 #include <streams.h>
 #include <sync.h>
 #include <tinyformat.h>
+#include <txdb.h>
 #include <uint256.h>
 #include <util/fs.h>
 #include <util/log.h>
+#include <util/threadnames.h>
 #include <validation.h>
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdio>
+#include <exception>
+#include <limits>
 #include <optional>
 #include <span>
 #include <string>
 
 namespace node {
 
+namespace {
+//! Serialized coins of one chunk of a chunked snapshot.
+struct SnapshotChunk {
+    uint64_t coins_count{0};
+    DataStream payload{};
+    uint256 checksum;
+};
+
+//! Serialize the coins of one txid range into chunks.
+std::vector<SnapshotChunk> DumpRange(CCoinsViewCursor& cursor, uint8_t range, const std::atomic<bool>& stop)
+{
+    std::vector<SnapshotChunk> chunks;
+    SnapshotChunk chunk;
+    auto finish_chunk{[&] {
+        chunk.checksum = Hash(chunk.payload);
+        chunks.push_back(std::move(chunk));
+        chunk = SnapshotChunk{};
+    }};
+
+    COutPoint key;
+    Coin coin;
+    Txid last_hash;
+    std::vector<std::pair<uint32_t, Coin>> coins;
+    // As in the unchunked format, the coins of a txid are written together.
+    auto write_coins{[&] {
+        chunk.payload << last_hash;
+        WriteCompactSize(chunk.payload, coins.size());
+        for (const auto& [n, coin] : coins) {
+            WriteCompactSize(chunk.payload, n);
+            chunk.payload << coin;
+        }
+        chunk.coins_count += coins.size();
+        coins.clear();
+        if (chunk.payload.size() >= SnapshotChunkWriter::CHUNK_TARGET_SIZE) finish_chunk();
+    }};
+
+    for (unsigned int iter{0}; cursor.Valid(); cursor.Next(), ++iter) {
+        if (iter % 5000 == 0 && stop) return {};
+        if (!cursor.GetKey(key) || !cursor.GetValue(coin)) continue;
+        if (std::to_integer<uint8_t>(key.hash.data()[0]) != range) break;
+        if (!coins.empty() && key.hash != last_hash) write_coins();
+        last_hash = key.hash;
+        coins.emplace_back(key.n, coin);
+    }
+    if (!coins.empty()) write_coins();
+    if (chunk.coins_count > 0) finish_chunk();
+    return chunks;
+}
+} // namespace
+
+SnapshotChunkWriter::SnapshotChunkWriter(const CCoinsViewDB& db)
+{
+    m_cursors.reserve(RANGES);
+    for (size_t range{0}; range < RANGES; ++range) {
+        uint256 start;
+        start.data()[0] = range;
+        m_cursors.push_back(db.Cursor(Txid::FromUint256(start)));
+    }
+}
+
+uint64_t SnapshotChunkWriter::Write(AutoFile& file, int threads, const std::function<void()>& interruption_point)
+{
+    Mutex mutex;
+    std::condition_variable cv;
+    // Serialized ranges waiting to be written, and whether each is complete.
+    std::vector<std::vector<SnapshotChunk>> ranges(RANGES);
+    std::vector<bool> done(RANGES);
+    size_t next_range{0};
+    size_t next_write{0};
+    std::exception_ptr error;
+    std::atomic<bool> stop{false};
+
+    threads = std::max(threads, 1);
+    // Limit how far the workers get ahead of the file, which bounds memory usage.
+    const size_t max_ahead{size_t(threads) + 1};
+    auto worker{[&] {
+        while (true) {
+            size_t range;
+            {
+                WAIT_LOCK(mutex, lock);
+                cv.wait(lock, [&] { return stop || next_range == RANGES || next_range < next_write + max_ahead; });
+                if (stop || next_range == RANGES) return;
+                range = next_range++;
+            }
+            try {
+                auto chunks{DumpRange(*m_cursors[range], range, stop)};
+                LOCK(mutex);
+                ranges[range] = std::move(chunks);
+                done[range] = true;
+            } catch (...) {
+                LOCK(mutex);
+                if (!error) error = std::current_exception();
+                stop = true;
+            }
+            cv.notify_all();
+        }
+    }};
+
+    std::vector<std::thread> workers;
+    auto join_workers{[&] {
+        stop = true;
+        cv.notify_all();
+        for (auto& t : workers) t.join();
+        workers.clear();
+    }};
+
+    uint64_t coins_written{0};
+    std::vector<SnapshotChunkInfo> index;
+    try {
+        for (int i{0}; i < threads; ++i) {
+            workers.emplace_back([&worker, i] {
+                util::ThreadRename(strprintf("snapshotdump.%i", i));
+                worker();
+            });
+        }
+        for (size_t range{0}; range < RANGES; ++range) {
+            std::vector<SnapshotChunk> chunks;
+            {
+                WAIT_LOCK(mutex, lock);
+                while (!done[range] && !error) {
+                    cv.wait_for(lock, std::chrono::milliseconds{100});
+                    if (interruption_point) interruption_point();
+                }
+                if (error) std::rethrow_exception(error);
+                chunks = std::move(ranges[range]);
+                next_write = range + 1;
+            }
+            cv.notify_all();
+            for (const auto& chunk : chunks) {
+                index.push_back({.offset = uint64_t(file.tell()), .coins_count = chunk.coins_count, .checksum = chunk.checksum});
+                WriteCompactSize(file, chunk.coins_count);
+                WriteCompactSize(file, chunk.payload.size());
+                file.write(chunk.payload);
+                file << chunk.checksum;
+                coins_written += chunk.coins_count;
+            }
+        }
+    } catch (...) {
+        join_workers();
+        throw;
+    }
+    join_workers();
+
+    const uint64_t index_offset(file.tell());
+    file << index << index_offset;
+    return coins_written;
+}
+
+SnapshotCoinsReader::SnapshotCoinsReader(AutoFile& file, uint64_t coins_count, int base_height, uint16_t version)
+    : m_file{file}, m_coins_count{coins_count}, m_base_height{base_height}, m_version{version}
+{
+    m_thread = std::thread{[this]() {
+        util::ThreadRename("snapshotload");
+        ThreadDecode();
+    }};
+}
+
+SnapshotCoinsReader::~SnapshotCoinsReader()
+{
+    WITH_LOCK(m_mutex, m_request_stop = true);
+    m_cv.notify_all();
+    m_thread.join();
+}
+
+bool SnapshotCoinsReader::Push(SnapshotCoins&& batch)
+{
+    WAIT_LOCK(m_mutex, lock);
+    m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_request_stop || m_batches.size() < MAX_QUEUED_BATCHES; });
+    if (m_request_stop) return false;
+    m_batches.push_back(std::move(batch));
+    m_cv.notify_all();
+    return true;
+}
+
+struct SnapshotCoinsReader::DecodeState {
+    uint64_t coins_read{0};
+    std::optional<std::string> error;
+    //! Hash of the coins so far, as long as they are in database order.
+    std::optional<HashWriter> hasher{HashWriter{}};
+    Txid last_txid;
+    uint32_t last_n{0};
+    SnapshotCoins batch;
+};
+
+template <typename Stream>
+bool SnapshotCoinsReader::DecodeCoins(Stream& s, uint64_t count, DecodeState& state)
+{
+    uint64_t coins_left{count};
+    while (coins_left > 0) {
+        Txid txid;
+        s >> txid;
+        size_t coins_per_txid{0};
+        coins_per_txid = ReadCompactSize(s);
+
+        if (coins_per_txid > coins_left) {
+            state.error = "Mismatch in coins count in snapshot metadata and actual snapshot data";
+            return true;
+        }
+        if (coins_per_txid > 0) {
+            if (state.coins_read > 0 && !(state.last_txid < txid)) state.hasher.reset();
+            state.last_txid = txid;
+        }
+
+        for (size_t i = 0; i < coins_per_txid; i++) {
+            COutPoint outpoint;
+            Coin coin;
+            outpoint.n = static_cast<uint32_t>(ReadCompactSize(s));
+            outpoint.hash = txid;
+            s >> coin;
+            if (coin.nHeight > m_base_height ||
+                outpoint.n >= std::numeric_limits<decltype(outpoint.n)>::max() // Avoid integer wrap-around in coinstats.cpp:ApplyHash
+            ) {
+                state.error = strprintf("Bad snapshot data after deserializing %d coins", state.coins_read);
+                return true;
+            }
+            if (!MoneyRange(coin.out.nValue)) {
+                state.error = strprintf("Bad snapshot data after deserializing %d coins - bad tx out value", state.coins_read);
+                return true;
+            }
+            if (state.hasher) {
+                if (i > 0 && outpoint.n <= state.last_n) {
+                    state.hasher.reset();
+                } else {
+                    kernel::ApplyCoinHash(*state.hasher, outpoint, coin);
+                }
+            }
+            state.last_n = outpoint.n;
+            state.batch.emplace_back(std::move(outpoint), std::move(coin));
+            --coins_left;
+            ++state.coins_read;
+
+            if (state.batch.size() == BATCH_SIZE) {
+                if (!Push(std::move(state.batch))) return false;
+                state.batch.clear();
+                state.batch.reserve(BATCH_SIZE);
+            }
+        }
+    }
+    return true;
+}
+
+bool SnapshotCoinsReader::DecodeChunks(DecodeState& state)
+{
+    uint64_t coins_left{m_coins_count};
+    std::vector<SnapshotChunkInfo> chunks;
+    while (coins_left > 0) {
+        SnapshotChunkInfo chunk;
+        chunk.offset = m_file.tell();
+        chunk.coins_count = ReadCompactSize(m_file);
+        if (chunk.coins_count > coins_left) {
+            state.error = "Mismatch in coins count in snapshot metadata and actual snapshot data";
+            return true;
+        }
+        DataStream payload;
+        payload.resize(ReadCompactSize(m_file));
+        m_file.read(payload);
+        chunk.checksum = Hash(payload);
+        uint256 checksum;
+        m_file >> checksum;
+        if (checksum != chunk.checksum) {
+            state.error = strprintf("Bad snapshot - checksum mismatch in chunk %d after deserializing %d coins", chunks.size(), state.coins_read);
+            return true;
+        }
+        if (!DecodeCoins(payload, chunk.coins_count, state)) return false;
+        if (state.error) return true;
+        if (!payload.empty()) {
+            state.error = strprintf("Bad snapshot - data left over in chunk %d after deserializing %d coins", chunks.size(), state.coins_read);
+            return true;
+        }
+        coins_left -= chunk.coins_count;
+        chunks.push_back(chunk);
+    }
+
+    const uint64_t expected_index_offset(m_file.tell());
+    std::vector<SnapshotChunkInfo> index;
+    uint64_t index_offset;
+    m_file >> index >> index_offset;
+    if (index != chunks || index_offset != expected_index_offset) {
+        state.error = "Bad snapshot - chunk index does not match the chunks";
+    }
+    return true;
+}
+
+void SnapshotCoinsReader::ThreadDecode()
+{
+    DecodeState state;
+    state.batch.reserve(BATCH_SIZE);
+    try {
+        const bool keep_going{m_version == SnapshotMetadata::CHUNKED_VERSION ? DecodeChunks(state) : DecodeCoins(m_file, m_coins_count, state)};
+        if (!keep_going) return;
+    } catch (const std::ios_base::failure&) {
+        state.error = strprintf("Bad snapshot format or truncated snapshot after deserializing %d coins", state.coins_read);
+    }
+
+    if (!state.error) {
+        try {
+            std::byte left_over_byte;
+            m_file >> left_over_byte;
+            state.error = strprintf("Bad snapshot - coins left over after deserializing %d coins", m_coins_count);
+        } catch (const std::ios_base::failure&) {
+            // We expect an exception since we should be out of coins.
+        }
+    }
+
+    // The caller only sees the coins decoded before an error, as it would
+    // if they were inserted as they are read.
+    if (!state.batch.empty() && !Push(std::move(state.batch))) return;
+    LOCK(m_mutex);
+    m_error = std::move(state.error);
+    if (state.hasher && !m_error) m_hash_serialized = state.hasher->GetHash();
+    m_done = true;
+    m_cv.notify_all();
+}
+
+std::optional<SnapshotCoins> SnapshotCoinsReader::Next()
+{
+    WAIT_LOCK(m_mutex, lock);
+    m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_done || !m_batches.empty(); });
+    if (m_batches.empty()) return std::nullopt;
+    SnapshotCoins batch{std::move(m_batches.front())};
+    m_batches.pop_front();
+    m_cv.notify_all();
+    return batch;
+}
+
+std::optional<std::string> SnapshotCoinsReader::GetError() const
+{
+    return WITH_LOCK(m_mutex, return m_error);
+}
+
+std::optional<uint256> SnapshotCoinsReader::HashSerialized() const
+{
+    return WITH_LOCK(m_mutex, return m_hash_serialized);
+}
+
 bool WriteSnapshotBaseBlockhash(Chainstate& snapshot_chainstate)
 {
     AssertLockHeld(::cs_main);
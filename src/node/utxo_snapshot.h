@@ -6,27 +6,40 @@
 #ifndef BITCOIN_NODE_UTXO_SNAPSHOT_H
 #define BITCOIN_NODE_UTXO_SNAPSHOT_H
 
+#include <coins.h>
 #include <kernel/chainparams.h>
 #include <kernel/cs_main.h>
 #include <kernel/messagestartchars.h>
+#include <primitives/transaction.h>
+#include <serialize.h>
 #include <sync.h>
 #include <tinyformat.h>
 #include <uint256.h>
+#include <util/byte_units.h>
 #include <util/chaintype.h>
 #include <util/fs.h>
 
 #include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <ios>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 // UTXO set snapshot magic bytes
 static constexpr std::array<uint8_t, 5> SNAPSHOT_MAGIC_BYTES = {'u', 't', 'x', 'o', 0xff};
 
+class AutoFile;
+class CCoinsViewDB;
 class Chainstate;
 
 namespace node {
@@ -36,10 +49,19 @@ namespace node {
 //! before being used. Thus, new fields should be added only if needed.
 class SnapshotMetadata
 {
-    inline static const uint16_t VERSION{2};
-    const std::set<uint16_t> m_supported_versions{VERSION};
+public:
+    //! Coins grouped by txid, in one sequence.
+    static constexpr uint16_t VERSION{2};
+    //! Coins grouped by txid, in checksummed chunks followed by a SnapshotChunkInfo index.
+    static constexpr uint16_t CHUNKED_VERSION{3};
+
+private:
+    const std::set<uint16_t> m_supported_versions{VERSION, CHUNKED_VERSION};
     const MessageStartChars m_network_magic;
 public:
+    //! The format of the coins following the metadata.
+    uint16_t m_version{VERSION};
+
     //! The hash of the block that reflects the tip of the chain for the
     //! UTXO set contained in this snapshot.
     uint256 m_base_blockhash;
@@ -55,15 +77,17 @@ public:
     SnapshotMetadata(
         const MessageStartChars network_magic,
         const uint256& base_blockhash,
-        uint64_t coins_count) :
+        uint64_t coins_count,
+        uint16_t version = VERSION) :
             m_network_magic(network_magic),
+            m_version(version),
             m_base_blockhash(base_blockhash),
             m_coins_count(coins_count) { }
 
     template <typename Stream>
     inline void Serialize(Stream& s) const {
         s << SNAPSHOT_MAGIC_BYTES;
-        s << VERSION;
+        s << m_version;
         s << m_network_magic;
         s << m_base_blockhash;
         s << m_coins_count;
@@ -84,6 +108,7 @@ public:
         if (!m_supported_versions.contains(version)) {
             throw std::ios_base::failure(strprintf("Version of snapshot %s does not match any of the supported versions.", version));
         }
+        m_version = version;
 
         // Read the network magic (pchMessageStart)
         MessageStartChars message;
@@ -105,6 +130,130 @@ public:
     }
 };
 
+/**
+ * Index entry of a chunk in a SnapshotMetadata::CHUNKED_VERSION snapshot.
+ *
+ * On disk a chunk is the compact size coins count, the compact size length of
+ * the serialized coins, the serialized coins in the same format as a
+ * SnapshotMetadata::VERSION snapshot, and the SHA256d of the serialized coins.
+ * A chunk never splits the coins of a txid, so each chunk can be checked and
+ * decoded on its own.
+ *
+ * The chunks are followed by the vector of their index entries and the
+ * uint64_t offset of that vector, which ends the file.
+ */
+struct SnapshotChunkInfo {
+    //! Offset of the chunk in the file.
+    uint64_t offset{0};
+    uint64_t coins_count{0};
+    //! SHA256d of the serialized coins of the chunk.
+    uint256 checksum;
+
+    SERIALIZE_METHODS(SnapshotChunkInfo, obj) { READWRITE(obj.offset, obj.coins_count, obj.checksum); }
+
+    friend bool operator==(const SnapshotChunkInfo&, const SnapshotChunkInfo&) = default;
+};
+
+/**
+ * Writes the coins of a SnapshotMetadata::CHUNKED_VERSION snapshot.
+ *
+ * The coins database is split into ranges by the first byte of the txid,
+ * which are serialized into chunks by a pool of threads. The chunks are
+ * written to the file in database order, so the streaming hash of
+ * SnapshotCoinsReader applies to them.
+ */
+class SnapshotChunkWriter
+{
+public:
+    //! Number of txid ranges the coins database is split into.
+    static constexpr size_t RANGES{256};
+    //! A chunk is closed at the first txid boundary after it reaches this size.
+    static constexpr size_t CHUNK_TARGET_SIZE{8_MiB};
+
+    /**
+     * Open cursors over the coins database. The cursors see the database as
+     * of their creation, so it must not be written to during this call.
+     */
+    explicit SnapshotChunkWriter(const CCoinsViewDB& db);
+
+    /**
+     * Write the chunks and the chunk index to `file`, which must be positioned
+     * after the snapshot metadata.
+     *
+     * @returns the number of coins written.
+     */
+    uint64_t Write(AutoFile& file, int threads, const std::function<void()>& interruption_point = {});
+
+private:
+    std::vector<std::unique_ptr<CCoinsViewCursor>> m_cursors;
+};
+
+//! Coins decoded from a snapshot, in file order.
+using SnapshotCoins = std::vector<std::pair<COutPoint, Coin>>;
+
+/**
+ * Decodes the coins of a snapshot file on a background thread, so that the
+ * caller can insert them into the coins cache while the rest of the file is
+ * being read.
+ *
+ * The coins are also hashed as they are decoded, the way ComputeUTXOStats()
+ * hashes the coins database, which saves reading the whole set back from the
+ * database to validate it. This only gives the same result if the coins
+ * appear in the order of the database, which is how dumptxoutset writes them.
+ * For files in any other order HashSerialized() returns nullopt, and the
+ * database has to be hashed instead.
+ */
+class SnapshotCoinsReader
+{
+public:
+    //! Number of coins handed to the caller at a time.
+    static constexpr size_t BATCH_SIZE{10'000};
+    //! Number of decoded batches the reader may get ahead of the caller by.
+    static constexpr size_t MAX_QUEUED_BATCHES{8};
+
+    //! Start decoding `coins_count` coins from `file`, which must outlive the reader.
+    SnapshotCoinsReader(AutoFile& file, uint64_t coins_count, int base_height, uint16_t version = SnapshotMetadata::VERSION);
+    ~SnapshotCoinsReader();
+
+    SnapshotCoinsReader(const SnapshotCoinsReader&) = delete;
+    SnapshotCoinsReader& operator=(const SnapshotCoinsReader&) = delete;
+
+    //! Return the next batch of coins, or nullopt once all coins were returned or decoding failed.
+    std::optional<SnapshotCoins> Next() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    //! Why decoding failed, if it did. Only meaningful after Next() returned nullopt.
+    std::optional<std::string> GetError() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    //! Hash of the coins if they were in database order. Only meaningful after Next() returned nullopt.
+    std::optional<uint256> HashSerialized() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    struct DecodeState;
+
+    AutoFile& m_file;
+    const uint64_t m_coins_count;
+    const int m_base_height;
+    const uint16_t m_version;
+
+    mutable Mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<SnapshotCoins> m_batches GUARDED_BY(m_mutex);
+    std::optional<std::string> m_error GUARDED_BY(m_mutex);
+    std::optional<uint256> m_hash_serialized GUARDED_BY(m_mutex);
+    bool m_done GUARDED_BY(m_mutex){false};
+    bool m_request_stop GUARDED_BY(m_mutex){false};
+    std::thread m_thread;
+
+    void ThreadDecode() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    //! Read the chunks and chunk index of a chunked snapshot.
+    bool DecodeChunks(DecodeState& state) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    //! Decode `count` coins from `s`. Returns false if the caller is no longer interested.
+    template <typename Stream>
+    bool DecodeCoins(Stream& s, uint64_t count, DecodeState& state) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    //! Hand a batch to the caller. Returns false if the caller is no longer interested.
+    bool Push(SnapshotCoins&& batch) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+};
+
 //! The file in the snapshot chainstate dir which stores the base blockhash. This is
 //! needed to reconstruct snapshot chainstates on init.
 //!
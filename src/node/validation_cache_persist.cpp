@@ -0,0 +1,148 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/validation_cache_persist.h>
+
+#include <clientversion.h>
+#include <hash.h>
+#include <logging.h>
+#include <script/sigcache.h>
+#include <serialize.h>
+#include <streams.h>
+#include <sync.h>
+#include <tinyformat.h>
+#include <uint256.h>
+#include <util/fs.h>
+#include <util/fs_helpers.h>
+#include <util/syserror.h>
+#include <util/time.h>
+#include <validation.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+using fsbridge::FopenFn;
+
+namespace node {
+
+static const uint64_t VALIDATION_CACHE_DUMP_VERSION{1};
+
+bool LoadValidationCache(ValidationCache& validation_cache, const fs::path& load_path, FopenFn mockable_fopen_function)
+{
+    if (load_path.empty()) return false;
+
+    AutoFile file{mockable_fopen_function(load_path, "rb")};
+    if (file.IsNull()) {
+        LogInfo("Failed to open validation cache file. Continuing anyway.");
+        return false;
+    }
+
+    try {
+        HashVerifier verifier{file};
+        uint64_t version;
+        verifier >> version;
+        if (version != VALIDATION_CACHE_DUMP_VERSION) {
+            LogInfo("Unsupported validation cache file version %u. Continuing anyway.", version);
+            return false;
+        }
+        int client_version;
+        uint256 signature_nonce, script_execution_nonce;
+        std::vector<uint256> signature_entries, script_execution_entries;
+        verifier >> client_version;
+        verifier >> signature_nonce >> signature_entries;
+        verifier >> script_execution_nonce >> script_execution_entries;
+
+        uint256 checksum;
+        file >> checksum;
+        if (checksum != verifier.GetHash()) {
+            throw std::runtime_error{"Checksum mismatch, data corrupted"};
+        }
+
+        // Only entries of the signature cache are independent of the script
+        // interpreter, which may have changed since they were written.
+        if (client_version != CLIENT_VERSION) {
+            LogInfo("Validation cache file was written by client version %d, not restoring the script execution cache.", client_version);
+            script_execution_entries.clear();
+        }
+
+        validation_cache.m_signature_cache.Restore(signature_nonce, signature_entries);
+        if (!script_execution_entries.empty()) {
+            LOCK(cs_main);
+            validation_cache.SetScriptExecutionCacheNonce(script_execution_nonce);
+            for (const uint256& entry : script_execution_entries) {
+                validation_cache.m_script_execution_cache.insert(entry);
+            }
+        }
+        LogInfo("Imported validation cache from file: %u signature cache entries, %u script execution cache entries",
+                signature_entries.size(), script_execution_entries.size());
+    } catch (const std::exception& e) {
+        LogInfo("Failed to deserialize validation cache data on file: %s. Continuing anyway.", e.what());
+        return false;
+    }
+    return true;
+}
+
+bool DumpValidationCache(ValidationCache& validation_cache, const fs::path& dump_path, FopenFn mockable_fopen_function, bool skip_file_commit)
+{
+    auto start = SteadyClock::now();
+
+    static Mutex dump_mutex;
+    LOCK(dump_mutex);
+
+    const uint256 signature_nonce{validation_cache.m_signature_cache.GetNonce()};
+    const std::vector<uint256> signature_entries{validation_cache.m_signature_cache.GetEntries()};
+    uint256 script_execution_nonce;
+    std::vector<uint256> script_execution_entries;
+    {
+        LOCK(cs_main);
+        script_execution_nonce = validation_cache.ScriptExecutionCacheNonce();
+        validation_cache.m_script_execution_cache.for_each([&](const uint256& entry) { script_execution_entries.push_back(entry); });
+    }
+
+    auto mid = SteadyClock::now();
+
+    const fs::path file_fspath{dump_path + ".new"};
+    AutoFile file{mockable_fopen_function(file_fspath, "wb")};
+    if (file.IsNull()) {
+        return false;
+    }
+
+    try {
+        HashedSourceWriter writer{file};
+        writer << VALIDATION_CACHE_DUMP_VERSION;
+        writer << CLIENT_VERSION;
+        writer << signature_nonce << signature_entries;
+        writer << script_execution_nonce << script_execution_entries;
+        file << writer.GetHash();
+
+        if (!skip_file_commit && !file.Commit()) {
+            (void)file.fclose();
+            throw std::runtime_error("Commit failed");
+        }
+        if (file.fclose() != 0) {
+            throw std::runtime_error(
+                strprintf("Error closing %s: %s", fs::PathToString(file_fspath), SysErrorString(errno)));
+        }
+        if (!RenameOver(dump_path + ".new", dump_path)) {
+            throw std::runtime_error("Rename failed");
+        }
+        auto last = SteadyClock::now();
+
+        LogInfo("Dumped validation cache: %u signature cache entries, %u script execution cache entries, %.3fs to copy, %.3fs to dump, %d bytes dumped to file",
+                signature_entries.size(), script_execution_entries.size(),
+                Ticks<SecondsDouble>(mid - start),
+                Ticks<SecondsDouble>(last - mid),
+                fs::file_size(dump_path));
+    } catch (const std::exception& e) {
+        LogInfo("Failed to dump validation cache: %s. Continuing anyway.", e.what());
+        (void)file.fclose();
+        return false;
+    }
+    return true;
+}
+
+} // namespace node
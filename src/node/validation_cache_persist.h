@@ -0,0 +1,40 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_VALIDATION_CACHE_PERSIST_H
+#define BITCOIN_NODE_VALIDATION_CACHE_PERSIST_H
+
+#include <util/fs.h>
+
+class ValidationCache;
+
+namespace node {
+
+/**
+ * Default for -persistvalidationcache, indicating whether the node should load
+ * the script execution and signature caches on start and save them to disk
+ * on shutdown
+ */
+static constexpr bool DEFAULT_PERSIST_VALIDATION_CACHE{false};
+
+/** Dump the script execution and signature caches, along with their salts, to a file. */
+bool DumpValidationCache(ValidationCache& validation_cache, const fs::path& dump_path,
+                         fsbridge::FopenFn mockable_fopen_function = fsbridge::fopen,
+                         bool skip_file_commit = false);
+
+/**
+ * Import the file into the script execution and signature caches, replacing
+ * their salts with the ones the entries were computed with.
+ *
+ * Must be called before any transaction or block is validated against the
+ * caches. The script execution cache is only restored if the file was written
+ * by the same client version, as its entries depend on the script
+ * interpreter's behaviour.
+ */
+bool LoadValidationCache(ValidationCache& validation_cache, const fs::path& load_path,
+                         fsbridge::FopenFn mockable_fopen_function = fsbridge::fopen);
+
+} // namespace node
+
+#endif // BITCOIN_NODE_VALIDATION_CACHE_PERSIST_H
@@ -94,7 +94,7 @@ public:
 
     SERIALIZE_METHODS(CBlock, obj)
     {
-        READWRITE(AsBase<CBlockHeader>(obj), obj.vtx);
+        READWRITE(AsBase<CBlockHeader>(obj), Using<TransactionsFormatter>(obj.vtx));
     }
 
     void SetNull()
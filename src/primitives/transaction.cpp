@@ -7,16 +7,19 @@
 
 #include <consensus/amount.h>
 #include <crypto/hex_base.h>
+#include <crypto/sha256.h>
 #include <hash.h>
 #include <primitives/transaction_identifier.h>
 #include <script/script.h>
 #include <serialize.h>
+#include <streams.h>
 #include <tinyformat.h>
 
 #include <algorithm>
 #include <cassert>
 #include <span>
 #include <stdexcept>
+#include <utility>
 
 std::string COutPoint::ToString() const
 {
@@ -94,6 +97,50 @@ Wtxid CTransaction::ComputeWitnessHash() const
 
 CTransaction::CTransaction(const CMutableTransaction& tx) : vin(tx.vin), vout(tx.vout), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
 CTransaction::CTransaction(CMutableTransaction&& tx) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
+CTransaction::CTransaction(PrecomputedHashesKey, CMutableTransaction&& tx, const Txid& hash, const Wtxid& witness_hash) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{hash}, m_witness_hash{witness_hash} {}
+
+bool CanBatchTransactionHashes()
+{
+    return SHA256DManyIsMultiLane();
+}
+
+std::vector<CTransactionRef> MakeTransactionRefs(std::vector<CMutableTransaction>&& txs)
+{
+    if (txs.empty()) return {};
+
+    // Serialize all transactions into one buffer: without witness for the
+    // txid, and again with witness for the wtxid if there is one.
+    std::vector<unsigned char> buffer;
+    std::vector<std::pair<size_t, size_t>> ranges;
+    ranges.reserve(2 * txs.size());
+    VectorWriter writer{buffer, 0};
+    for (const CMutableTransaction& tx : txs) {
+        const size_t start{buffer.size()};
+        writer << TX_NO_WITNESS(tx);
+        ranges.emplace_back(start, buffer.size() - start);
+        if (tx.HasWitness()) {
+            const size_t witness_start{buffer.size()};
+            writer << TX_WITH_WITNESS(tx);
+            ranges.emplace_back(witness_start, buffer.size() - witness_start);
+        }
+    }
+
+    std::vector<std::span<const unsigned char>> inputs;
+    inputs.reserve(ranges.size());
+    for (const auto& [start, size] : ranges) inputs.emplace_back(buffer.data() + start, size);
+    std::vector<uint256> hashes(inputs.size());
+    SHA256DMany(hashes.front().begin(), inputs.data(), inputs.size());
+
+    std::vector<CTransactionRef> ret;
+    ret.reserve(txs.size());
+    auto hash{hashes.begin()};
+    for (CMutableTransaction& tx : txs) {
+        const Txid txid{Txid::FromUint256(*hash++)};
+        const Wtxid wtxid{Wtxid::FromUint256(tx.HasWitness() ? *hash++ : txid.ToUint256())};
+        ret.push_back(std::make_shared<const CTransaction>(CTransaction::PrecomputedHashesKey{}, std::move(tx), txid, wtxid));
+    }
+    return ret;
+}
 
 CAmount CTransaction::GetValueOut() const
 {
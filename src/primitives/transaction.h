@@ -305,9 +305,17 @@ private:
     bool ComputeHasWitness() const;
 
 public:
+    /** Restricts construction from precomputed hashes to MakeTransactionRefs(). */
+    class PrecomputedHashesKey
+    {
+        PrecomputedHashesKey() = default;
+        friend std::vector<std::shared_ptr<const CTransaction>> MakeTransactionRefs(std::vector<CMutableTransaction>&& txs);
+    };
+
     /** Convert a CMutableTransaction into a CTransaction. */
     explicit CTransaction(const CMutableTransaction& tx);
     explicit CTransaction(CMutableTransaction&& tx);
+    CTransaction(PrecomputedHashesKey, CMutableTransaction&& tx, const Txid& hash, const Wtxid& witness_hash);
 
     template <typename Stream>
     inline void Serialize(Stream& s) const {
@@ -403,4 +411,33 @@ struct CMutableTransaction
 typedef std::shared_ptr<const CTransaction> CTransactionRef;
 template <typename Tx> static inline CTransactionRef MakeTransactionRef(Tx&& txIn) { return std::make_shared<const CTransaction>(std::forward<Tx>(txIn)); }
 
+/** Convert many transactions at once, computing all their txids and wtxids together with SHA256DMany(). */
+std::vector<CTransactionRef> MakeTransactionRefs(std::vector<CMutableTransaction>&& txs);
+
+/** Whether MakeTransactionRefs() is faster than hashing transactions one at a time on this CPU. */
+bool CanBatchTransactionHashes();
+
+/** Formatter for the transactions of a block, which computes their hashes together on deserialization
+ *  when a multi-lane SHA256 implementation is available. */
+struct TransactionsFormatter {
+    template <typename Stream>
+    void Ser(Stream& s, const std::vector<CTransactionRef>& txs)
+    {
+        s << txs;
+    }
+
+    template <typename Stream>
+    void Unser(Stream& s, std::vector<CTransactionRef>& txs)
+    {
+        if (!CanBatchTransactionHashes()) {
+            // Serializing every transaction again only pays off when the hashes are interleaved.
+            s >> txs;
+            return;
+        }
+        std::vector<CMutableTransaction> mtxs;
+        s >> mtxs;
+        txs = MakeTransactionRefs(std::move(mtxs));
+    }
+};
+
 #endif // BITCOIN_PRIMITIVES_TRANSACTION_H
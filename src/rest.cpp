@@ -423,9 +423,9 @@ static bool rest_block(const std::any& context,
         pos = pblockindex->GetBlockPos();
     }
 
-    const auto block_data{chainman.m_blockman.ReadRawBlock(pos, block_part)};
-    if (!block_data) {
-        switch (block_data.error()) {
+    const auto raw_block{chainman.m_blockman.ReadRawBlockData(pos, block_part)};
+    if (!raw_block) {
+        switch (raw_block.error()) {
         case node::ReadRawError::IO: return RESTERR(req, HTTP_INTERNAL_SERVER_ERROR, "I/O error reading " + hashStr);
         case node::ReadRawError::BadPartRange:
             assert(block_part);
@@ -433,16 +433,18 @@ static bool rest_block(const std::any& context,
         } // no default case, so the compiler can warn about missing cases
         assert(false);
     }
+    std::vector<std::byte> buffer;
+    const auto block_data{raw_block->Data(buffer)};
 
     switch (rf) {
     case RESTResponseFormat::BINARY: {
         req->WriteHeader("Content-Type", "application/octet-stream");
-        req->WriteReply(HTTP_OK, *block_data);
+        req->WriteReply(HTTP_OK, block_data);
         return true;
     }
 
     case RESTResponseFormat::HEX: {
-        const std::string strHex{HexStr(*block_data) + "\n"};
+        const std::string strHex{HexStr(block_data) + "\n"};
         req->WriteHeader("Content-Type", "text/plain");
         req->WriteReply(HTTP_OK, strHex);
         return true;
@@ -451,7 +453,7 @@ static bool rest_block(const std::any& context,
     case RESTResponseFormat::JSON: {
         if (tx_verbosity) {
             CBlock block{};
-            SpanReader{*block_data} >> TX_WITH_WITNESS(block);
+            SpanReader{block_data} >> TX_WITH_WITNESS(block);
             UniValue objBlock = blockToJSON(chainman.m_blockman, block, *tip, *pblockindex, *tx_verbosity, chainman.GetConsensus().powLimit);
             std::string strJSON = objBlock.write() + "\n";
             req->WriteHeader("Content-Type", "application/json");
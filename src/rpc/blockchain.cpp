@@ -12,6 +12,7 @@
 #include <clientversion.h>
 #include <coins.h>
 #include <common/args.h>
+#include <common/system.h>
 #include <consensus/amount.h>
 #include <consensus/params.h>
 #include <consensus/validation.h>
@@ -72,18 +73,25 @@ using interfaces::BlockRef;
 using interfaces::Mining;
 using node::BlockManager;
 using node::NodeContext;
+using node::SnapshotChunkWriter;
 using node::SnapshotMetadata;
 using util::MakeUnorderedList;
 
-std::tuple<std::unique_ptr<CCoinsViewCursor>, CCoinsStats, const CBlockIndex*>
+//! Number of threads writing a chunked UTXO snapshot.
+static constexpr int MAX_SNAPSHOT_DUMP_THREADS{8};
+
+std::tuple<std::unique_ptr<CCoinsViewCursor>, std::unique_ptr<SnapshotChunkWriter>, CCoinsStats, const CBlockIndex*>
 PrepareUTXOSnapshot(
     Chainstate& chainstate,
+    uint16_t version,
     const std::function<void()>& interruption_point = {})
     EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
 UniValue WriteUTXOSnapshot(
     Chainstate& chainstate,
+    uint16_t version,
     CCoinsViewCursor* pcursor,
+    SnapshotChunkWriter* chunk_writer,
     CCoinsStats* maybe_stats,
     const CBlockIndex* tip,
     AutoFile&& afile,
@@ -3065,6 +3073,9 @@ static RPCHelpMan dumptxoutset()
                     {"rollback", RPCArg::Type::NUM, RPCArg::Optional::OMITTED,
                         "Height or hash of the block to roll back to before creating the snapshot. Note: The further this number is from the tip, the longer this process will take. Consider setting a higher -rpcclienttimeout value in this case.",
                     RPCArgOptions{.skip_type_check = true, .type_str = {"", "string or numeric"}}},
+                    {"version", RPCArg::Type::NUM, RPCArg::Default{SnapshotMetadata::VERSION},
+                        strprintf("The snapshot format version. Version %d writes the coins in checksummed chunks followed by a chunk index, using multiple threads. "
+                                  "Such snapshots can only be loaded by nodes supporting that version.", SnapshotMetadata::CHUNKED_VERSION)},
                 },
             },
         },
@@ -3106,6 +3117,11 @@ static RPCHelpMan dumptxoutset()
     } else {
         throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Invalid snapshot type \"%s\" specified. Please specify \"rollback\" or \"latest\"", snapshot_type));
     }
+    const int requested_version{options.exists("version") ? options["version"].getInt<int>() : SnapshotMetadata::VERSION};
+    if (requested_version != SnapshotMetadata::VERSION && requested_version != SnapshotMetadata::CHUNKED_VERSION) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Unsupported snapshot version %d", requested_version));
+    }
+    const uint16_t version{static_cast<uint16_t>(requested_version)};
 
     const ArgsManager& args{EnsureAnyArgsman(request.context)};
     const fs::path path = fsbridge::AbsPathJoin(args.GetDataDirNet(), fs::u8path(self.Arg<std::string_view>("path")));
@@ -3165,6 +3181,7 @@ static RPCHelpMan dumptxoutset()
 
     Chainstate* chainstate;
     std::unique_ptr<CCoinsViewCursor> cursor;
+    std::unique_ptr<SnapshotChunkWriter> chunk_writer;
     CCoinsStats stats;
     {
         // Lock the chainstate before calling PrepareUtxoSnapshot, to be able
@@ -3185,12 +3202,14 @@ static RPCHelpMan dumptxoutset()
             LogWarning("dumptxoutset failed to roll back to requested height, reverting to tip.\n");
             throw JSONRPCError(RPC_MISC_ERROR, "Could not roll back to requested height.");
         } else {
-            std::tie(cursor, stats, tip) = PrepareUTXOSnapshot(*chainstate, node.rpc_interruption_point);
+            std::tie(cursor, chunk_writer, stats, tip) = PrepareUTXOSnapshot(*chainstate, version, node.rpc_interruption_point);
         }
     }
 
     UniValue result = WriteUTXOSnapshot(*chainstate,
+                                        version,
                                         cursor.get(),
+                                        chunk_writer.get(),
                                         &stats,
                                         tip,
                                         std::move(afile),
@@ -3205,12 +3224,14 @@ static RPCHelpMan dumptxoutset()
     };
 }
 
-std::tuple<std::unique_ptr<CCoinsViewCursor>, CCoinsStats, const CBlockIndex*>
+std::tuple<std::unique_ptr<CCoinsViewCursor>, std::unique_ptr<SnapshotChunkWriter>, CCoinsStats, const CBlockIndex*>
 PrepareUTXOSnapshot(
     Chainstate& chainstate,
+    uint16_t version,
     const std::function<void()>& interruption_point)
 {
     std::unique_ptr<CCoinsViewCursor> pcursor;
+    std::unique_ptr<SnapshotChunkWriter> chunk_writer;
     std::optional<CCoinsStats> maybe_stats;
     const CBlockIndex* tip;
 
@@ -3236,31 +3257,20 @@ PrepareUTXOSnapshot(
             throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read UTXO set");
         }
 
-        pcursor = chainstate.CoinsDB().Cursor();
+        if (version == SnapshotMetadata::CHUNKED_VERSION) {
+            chunk_writer = std::make_unique<SnapshotChunkWriter>(chainstate.CoinsDB());
+        } else {
+            pcursor = chainstate.CoinsDB().Cursor();
+        }
         tip = CHECK_NONFATAL(chainstate.m_blockman.LookupBlockIndex(maybe_stats->hashBlock));
     }
 
-    return {std::move(pcursor), *CHECK_NONFATAL(maybe_stats), tip};
+    return {std::move(pcursor), std::move(chunk_writer), *CHECK_NONFATAL(maybe_stats), tip};
 }
 
-UniValue WriteUTXOSnapshot(
-    Chainstate& chainstate,
-    CCoinsViewCursor* pcursor,
-    CCoinsStats* maybe_stats,
-    const CBlockIndex* tip,
-    AutoFile&& afile,
-    const fs::path& path,
-    const fs::path& temppath,
-    const std::function<void()>& interruption_point)
+//! Write the coins of a SnapshotMetadata::VERSION snapshot. Returns the number of coins written.
+static size_t WriteSnapshotCoins(CCoinsViewCursor& cursor, AutoFile& afile, const std::function<void()>& interruption_point)
 {
-    LOG_TIME_SECONDS(strprintf("writing UTXO snapshot at height %s (%s) to file %s (via %s)",
-        tip->nHeight, tip->GetBlockHash().ToString(),
-        fs::PathToString(path), fs::PathToString(temppath)));
-
-    SnapshotMetadata metadata{chainstate.m_chainman.GetParams().MessageStart(), tip->GetBlockHash(), maybe_stats->coins_count};
-
-    afile << metadata;
-
     COutPoint key;
     Txid last_hash;
     Coin coin;
@@ -3285,12 +3295,12 @@ UniValue WriteUTXOSnapshot(
         }
     };
 
-    pcursor->GetKey(key);
+    cursor.GetKey(key);
     last_hash = key.hash;
-    while (pcursor->Valid()) {
-        if (iter % 5000 == 0) interruption_point();
+    while (cursor.Valid()) {
+        if (iter % 5000 == 0 && interruption_point) interruption_point();
         ++iter;
-        if (pcursor->GetKey(key) && pcursor->GetValue(coin)) {
+        if (cursor.GetKey(key) && cursor.GetValue(coin)) {
             if (key.hash != last_hash) {
                 write_coins_to_file(afile, last_hash, coins, written_coins_count);
                 last_hash = key.hash;
@@ -3298,13 +3308,43 @@ UniValue WriteUTXOSnapshot(
             }
             coins.emplace_back(key.n, coin);
         }
-        pcursor->Next();
+        cursor.Next();
     }
 
     if (!coins.empty()) {
         write_coins_to_file(afile, last_hash, coins, written_coins_count);
     }
 
+    return written_coins_count;
+}
+
+UniValue WriteUTXOSnapshot(
+    Chainstate& chainstate,
+    uint16_t version,
+    CCoinsViewCursor* pcursor,
+    SnapshotChunkWriter* chunk_writer,
+    CCoinsStats* maybe_stats,
+    const CBlockIndex* tip,
+    AutoFile&& afile,
+    const fs::path& path,
+    const fs::path& temppath,
+    const std::function<void()>& interruption_point)
+{
+    LOG_TIME_SECONDS(strprintf("writing UTXO snapshot at height %s (%s) to file %s (via %s)",
+        tip->nHeight, tip->GetBlockHash().ToString(),
+        fs::PathToString(path), fs::PathToString(temppath)));
+
+    SnapshotMetadata metadata{chainstate.m_chainman.GetParams().MessageStart(), tip->GetBlockHash(), maybe_stats->coins_count, version};
+
+    afile << metadata;
+
+    size_t written_coins_count{0};
+    if (chunk_writer) {
+        written_coins_count = chunk_writer->Write(afile, std::clamp(GetNumCores(), 1, MAX_SNAPSHOT_DUMP_THREADS), interruption_point);
+    } else {
+        written_coins_count = WriteSnapshotCoins(*pcursor, afile, interruption_point);
+    }
+
     CHECK_NONFATAL(written_coins_count == maybe_stats->coins_count);
 
     if (afile.fclose() != 0) {
@@ -3327,11 +3367,14 @@ UniValue CreateUTXOSnapshot(
     Chainstate& chainstate,
     AutoFile&& afile,
     const fs::path& path,
-    const fs::path& tmppath)
+    const fs::path& tmppath,
+    uint16_t version)
 {
-    auto [cursor, stats, tip]{WITH_LOCK(::cs_main, return PrepareUTXOSnapshot(chainstate, node.rpc_interruption_point))};
+    auto [cursor, chunk_writer, stats, tip]{WITH_LOCK(::cs_main, return PrepareUTXOSnapshot(chainstate, version, node.rpc_interruption_point))};
     return WriteUTXOSnapshot(chainstate,
+                             version,
                              cursor.get(),
+                             chunk_writer.get(),
                              &stats,
                              tip,
                              std::move(afile),
@@ -17,6 +17,7 @@
 #include <interfaces/ipc.h>
 #include <kernel/cs_main.h>
 #include <logging.h>
+#include <node/blockstorage.h>
 #include <node/context.h>
 #include <rpc/server.h>
 #include <rpc/server_util.h>
@@ -27,6 +28,7 @@
 #include <util/any.h>
 #include <util/check.h>
 #include <util/time.h>
+#include <validation.h>
 
 #include <cstdint>
 #ifdef HAVE_MALLOC_INFO
@@ -123,6 +125,18 @@ static UniValue RPCLockedMemoryInfo()
     return obj;
 }
 
+static UniValue RPCBlockCacheInfo(const node::BlockManager& blockman)
+{
+    const auto stats{blockman.GetBlockCacheStats()};
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("entries", stats.entries);
+    obj.pushKV("usage", stats.usage);
+    obj.pushKV("max_usage", stats.max_usage);
+    obj.pushKV("hits", stats.hits);
+    obj.pushKV("misses", stats.misses);
+    return obj;
+}
+
 #ifdef HAVE_MALLOC_INFO
 static std::string RPCMallocInfo()
 {
@@ -167,6 +181,14 @@ static RPCHelpMan getmemoryinfo()
                                 {RPCResult::Type::NUM, "chunks_used", "Number allocated chunks"},
                                 {RPCResult::Type::NUM, "chunks_free", "Number unused chunks"},
                             }},
+                            {RPCResult::Type::OBJ, "blockcache", /*optional=*/true, "Information about the cache of blocks recently read from disk (see -blockreadcache)",
+                            {
+                                {RPCResult::Type::NUM, "entries", "Number of cached blocks"},
+                                {RPCResult::Type::NUM, "usage", "Number of bytes used by the cached blocks"},
+                                {RPCResult::Type::NUM, "max_usage", "Maximum number of bytes used by the cached blocks"},
+                                {RPCResult::Type::NUM, "hits", "Number of block reads served from the cache"},
+                                {RPCResult::Type::NUM, "misses", "Number of block reads that were not served from the cache"},
+                            }},
                         }
                     },
                     RPCResult{"mode \"mallocinfo\"",
@@ -183,6 +205,8 @@ static RPCHelpMan getmemoryinfo()
     if (mode == "stats") {
         UniValue obj(UniValue::VOBJ);
         obj.pushKV("locked", RPCLockedMemoryInfo());
+        const NodeContext& node_context{EnsureAnyNodeContext(request.context)};
+        if (node_context.chainman) obj.pushKV("blockcache", RPCBlockCacheInfo(node_context.chainman->m_blockman));
         return obj;
     } else if (mode == "mallocinfo") {
 #ifdef HAVE_MALLOC_INFO
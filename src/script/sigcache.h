@@ -38,6 +38,8 @@ static_assert(DEFAULT_VALIDATION_CACHE_BYTES == DEFAULT_SIGNATURE_CACHE_BYTES +
 class SignatureCache
 {
 private:
+    //! Salt of the entries, from which the salted hashers are derived.
+    uint256 m_nonce;
     //! Entries are SHA256(nonce || 'E' or 'S' || 31 zero bytes || signature hash || public key || signature):
     CSHA256 m_salted_hasher_ecdsa;
     CSHA256 m_salted_hasher_schnorr;
@@ -58,6 +60,25 @@ public:
     bool Get(const uint256& entry, bool erase);
 
     void Set(const uint256& entry);
+
+    //! Return the salt of the cache entries.
+    uint256 GetNonce() const { return m_nonce; }
+
+    //! Return all entries currently in the cache.
+    std::vector<uint256> GetEntries();
+
+    /**
+     * Replace the salt of the cache and insert entries computed with it, e.g.
+     * entries persisted by a previous run. Entries computed with the previous
+     * salt can no longer be matched.
+     *
+     * Must not be called while signatures are being checked against this
+     * cache, as the salted hashers are not protected by the cache lock.
+     */
+    void Restore(const uint256& nonce, std::span<const uint256> entries);
+
+private:
+    void SetNonce(const uint256& nonce);
 };
 
 class CachingTransactionSignatureChecker : public TransactionSignatureChecker
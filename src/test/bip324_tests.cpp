@@ -85,6 +85,21 @@ void TestBIP324PacketVector(
     std::vector<std::byte> ciphertext(contents.size() + cipher.EXPANSION);
     cipher.Encrypt(contents, in_aad, in_ignore, ciphertext);
 
+    // Encrypting the contents in place, after the length and header in the output, gives the
+    // same ciphertext.
+    {
+        BIP324Cipher inplace_cipher(key, ellswift_ours);
+        inplace_cipher.Initialize(ellswift_theirs, in_initiating);
+        for (uint32_t i = 0; i < in_idx; ++i) {
+            inplace_cipher.Encrypt({}, {}, true, dummies[i]);
+        }
+        std::vector<std::byte> inplace(contents.size() + cipher.EXPANSION);
+        const auto inplace_contents{std::span{inplace}.subspan(cipher.LENGTH_LEN + cipher.HEADER_LEN, contents.size())};
+        std::ranges::copy(contents, inplace_contents.begin());
+        inplace_cipher.Encrypt(inplace_contents, in_aad, in_ignore, inplace);
+        BOOST_CHECK(inplace == ciphertext);
+    }
+
     // Verify ciphertext. Note that the test vectors specify either out_ciphertext (for short
     // messages) or out_ciphertext_endswith (for long messages), so only check the relevant one.
     if (!out_ciphertext.empty()) {
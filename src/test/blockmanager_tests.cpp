@@ -10,6 +10,7 @@
 #include <node/kernel_notifications.h>
 #include <script/solver.h>
 #include <primitives/block.h>
+#include <util/byte_units.h>
 #include <util/chaintype.h>
 #include <validation.h>
 
@@ -300,4 +301,221 @@ BOOST_AUTO_TEST_CASE(blockmanager_flush_block_file)
     BOOST_CHECK_EQUAL(read_block.nVersion, 2);
 }
 
+BOOST_AUTO_TEST_CASE(blockmanager_read_raw_block_data)
+{
+    KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
+    node::BlockManager::Options blockman_opts{
+        .chainparams = Params(),
+        .use_mmap = true,
+        .fast_prune = true,
+        .blocks_dir = m_args.GetBlocksDirPath(),
+        .notifications = notifications,
+        .block_tree_db_params = DBParams{
+            .path = m_args.GetDataDirNet() / "blocks" / "index",
+            .cache_bytes = 0,
+        },
+    };
+    BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+
+    // Write enough blocks to fill the first, small block file.
+    const CBlock& block{Params().GenesisBlock()};
+    std::vector<FlatFilePos> positions;
+    while (positions.empty() || positions.back().nFile == 0) {
+        positions.push_back(blockman.WriteBlock(block, /*nHeight=*/positions.size()));
+    }
+
+    for (const FlatFilePos& pos : {positions.front(), positions.back()}) {
+        const auto expected{blockman.ReadRawBlock(pos)};
+        BOOST_REQUIRE(expected);
+        const auto raw_block{blockman.ReadRawBlockData(pos)};
+        BOOST_REQUIRE(raw_block);
+        BOOST_CHECK_EQUAL(raw_block->size(), expected->size());
+
+        std::vector<std::byte> buffer;
+        BOOST_CHECK(std::ranges::equal(raw_block->Data(buffer), *expected));
+#ifndef WIN32
+        // Only the finalized file is mapped, the data of which needs deobfuscating.
+        BOOST_CHECK_EQUAL(buffer.empty(), pos.nFile != 0);
+#endif
+        DataStream serialized;
+        serialized << *raw_block;
+        BOOST_CHECK(std::ranges::equal(serialized, *expected));
+
+        const auto part{blockman.ReadRawBlockData(pos, std::pair{size_t{10}, size_t{20}})};
+        BOOST_REQUIRE(part);
+        BOOST_CHECK(std::ranges::equal(part->Data(buffer), std::span{*expected}.subspan(10, 20)));
+        BOOST_CHECK(blockman.ReadRawBlockData(pos, std::pair{expected->size(), size_t{1}}).error() == node::ReadRawError::BadPartRange);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(blockmanager_async_writes)
+{
+    KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
+    node::BlockManager::Options blockman_opts{
+        .chainparams = Params(),
+        .async_writes = true,
+        .fast_prune = true,
+        .blocks_dir = m_args.GetBlocksDirPath(),
+        .notifications = notifications,
+        .block_tree_db_params = DBParams{
+            .path = m_args.GetDataDirNet() / "blocks" / "index",
+            .cache_bytes = 0,
+        },
+    };
+    BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+
+    // Write enough blocks to move on from the first, small block file, which is finalized.
+    const CBlock& block{Params().GenesisBlock()};
+    std::vector<FlatFilePos> positions;
+    while (positions.empty() || positions.back().nFile == 0) {
+        positions.push_back(blockman.WriteBlock(block, /*nHeight=*/positions.size()));
+    }
+
+    // Reads wait for the queued data, whether or not it has been written yet.
+    DataStream expected;
+    expected << TX_WITH_WITNESS(block);
+    for (const FlatFilePos& pos : positions) {
+        const auto raw_block{blockman.ReadRawBlock(pos)};
+        BOOST_REQUIRE(raw_block);
+        BOOST_CHECK(std::ranges::equal(*raw_block, expected));
+    }
+    CBlock read_block;
+    BOOST_CHECK(blockman.ReadBlock(read_block, positions.back(), block.GetHash()));
+
+    BOOST_CHECK(blockman.WaitForBlockWrites());
+    // The finalization of the first file was queued after its blocks, and truncated it.
+    BOOST_CHECK_EQUAL(fs::file_size(blockman.GetBlockPosFilename({0, 0})), blockman.GetBlockFileInfo(0)->nSize);
+}
+
+BOOST_AUTO_TEST_CASE(blockmanager_read_raw_blocks)
+{
+    KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
+    node::BlockManager::Options blockman_opts{
+        .chainparams = Params(),
+        .block_read_threads = 2,
+        .blocks_dir = m_args.GetBlocksDirPath(),
+        .notifications = notifications,
+        .block_tree_db_params = DBParams{
+            .path = m_args.GetDataDirNet() / "blocks" / "index",
+            .cache_bytes = 0,
+        },
+    };
+    BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+
+    const CBlock& block{Params().GenesisBlock()};
+    std::vector<FlatFilePos> positions;
+    for (int height{0}; height < 20; ++height) {
+        positions.push_back(blockman.WriteBlock(block, height));
+    }
+    // A position without a block is reported in place.
+    positions.insert(positions.begin() + 5, FlatFilePos{0, 0});
+
+    DataStream expected;
+    expected << TX_WITH_WITNESS(block);
+    const auto results{blockman.ReadRawBlocks(positions)};
+    BOOST_REQUIRE_EQUAL(results.size(), positions.size());
+    for (size_t i{0}; i < results.size(); ++i) {
+        if (i == 5) {
+            BOOST_REQUIRE(!results[i]);
+            BOOST_CHECK_EQUAL(results[i].error(), node::ReadRawError::IO);
+        } else {
+            BOOST_REQUIRE(results[i]);
+            BOOST_CHECK(std::ranges::equal(*results[i], expected));
+        }
+    }
+    BOOST_CHECK(blockman.ReadRawBlocks({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(blockmanager_async_prune)
+{
+    KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
+    node::BlockManager::Options blockman_opts{
+        .chainparams = Params(),
+        .async_prune = true,
+        .fast_prune = true,
+        .blocks_dir = m_args.GetBlocksDirPath(),
+        .notifications = notifications,
+        .block_tree_db_params = DBParams{
+            .path = m_args.GetDataDirNet() / "blocks" / "index",
+            .cache_bytes = 0,
+        },
+    };
+    BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+
+    // Fill the first two block files.
+    const CBlock& block{Params().GenesisBlock()};
+    std::vector<FlatFilePos> positions;
+    while (positions.empty() || positions.back().nFile < 2) {
+        positions.push_back(blockman.WriteBlock(block, /*nHeight=*/positions.size()));
+    }
+    BOOST_REQUIRE(fs::exists(blockman.GetBlockPosFilename({0, 0})));
+    BOOST_REQUIRE(fs::exists(blockman.GetBlockPosFilename({1, 0})));
+
+    blockman.ScheduleUnlinkPrunedFiles({0});
+    blockman.ScheduleUnlinkPrunedFiles({1});
+    blockman.WaitForPrunedFileUnlinks();
+    BOOST_CHECK(!fs::exists(blockman.GetBlockPosFilename({0, 0})));
+    BOOST_CHECK(!fs::exists(blockman.GetBlockPosFilename({1, 0})));
+    BOOST_CHECK(fs::exists(blockman.GetBlockPosFilename({2, 0})));
+    BOOST_CHECK(blockman.ReadRawBlock(positions.back()));
+}
+
+BOOST_AUTO_TEST_CASE(blockmanager_block_cache)
+{
+    KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
+    node::BlockManager::Options blockman_opts{
+        .chainparams = Params(),
+        .block_cache_bytes = 1_MiB,
+        .blocks_dir = m_args.GetBlocksDirPath(),
+        .notifications = notifications,
+        .block_tree_db_params = DBParams{
+            .path = m_args.GetDataDirNet() / "blocks" / "index",
+            .cache_bytes = 0,
+        },
+    };
+    BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+
+    const CBlock& block{Params().GenesisBlock()};
+    const FlatFilePos pos{blockman.WriteBlock(block, /*nHeight=*/0)};
+    CBlock read_block;
+
+    // Only reads for a known hash use the cache.
+    BOOST_CHECK(blockman.ReadBlock(read_block, pos, {}));
+    BOOST_CHECK_EQUAL(blockman.GetBlockCacheStats().entries, 0U);
+
+    BOOST_CHECK(blockman.ReadBlock(read_block, pos, block.GetHash()));
+    BOOST_CHECK(blockman.ReadBlock(read_block, pos, block.GetHash()));
+    BOOST_CHECK_EQUAL(read_block.GetHash(), block.GetHash());
+    auto stats{blockman.GetBlockCacheStats()};
+    BOOST_CHECK_EQUAL(stats.entries, 1U);
+    BOOST_CHECK_EQUAL(stats.hits, 1U);
+    BOOST_CHECK_EQUAL(stats.misses, 1U);
+    BOOST_CHECK_GT(stats.usage, 0U);
+    BOOST_CHECK_LE(stats.usage, stats.max_usage);
+
+    // Pruned blocks have a null position and are not served from the cache.
+    BOOST_CHECK(!blockman.ReadBlock(read_block, FlatFilePos{}, block.GetHash()));
+    BOOST_CHECK_EQUAL(blockman.GetBlockCacheStats().hits, 1U);
+
+    // The least recently used blocks are evicted once the limit is reached.
+    const auto cached_block{std::make_shared<const CBlock>(block)};
+    node::BlockCache cache{3 * stats.usage};
+    const uint256 hash1{m_rng.rand256()}, hash2{m_rng.rand256()}, hash3{m_rng.rand256()}, hash4{m_rng.rand256()};
+    cache.Insert(hash1, cached_block);
+    cache.Insert(hash2, cached_block);
+    cache.Insert(hash3, cached_block);
+    BOOST_CHECK(cache.Get(hash1));
+    cache.Insert(hash4, cached_block);
+    BOOST_CHECK_EQUAL(cache.GetStats().entries, 3U);
+    BOOST_CHECK(cache.Get(hash1));
+    BOOST_CHECK(!cache.Get(hash2));
+    BOOST_CHECK(cache.Get(hash3));
+    BOOST_CHECK(cache.Get(hash4));
+
+    // A block that alone exceeds the limit is not cached.
+    node::BlockCache small_cache{stats.usage - 1};
+    small_cache.Insert(hash1, cached_block);
+    BOOST_CHECK_EQUAL(small_cache.GetStats().entries, 0U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
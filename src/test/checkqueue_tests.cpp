@@ -35,7 +35,7 @@ struct NoLockLoggingTestingSetup : public TestingSetup {
 };
 
 struct CheckQueueTest : NoLockLoggingTestingSetup {
-    void Correct_Queue_range(std::vector<size_t> range);
+    void Correct_Queue_range(std::vector<size_t> range, CheckQueueScheduler scheduler = CheckQueueScheduler::SHARED_QUEUE);
 };
 
 static const unsigned int QUEUE_BATCH_SIZE = 128;
@@ -156,9 +156,9 @@ typedef CCheckQueue<FrozenCleanupCheck> FrozenCleanup_Queue;
 /** This test case checks that the CCheckQueue works properly
  * with each specified size_t Checks pushed.
  */
-void CheckQueueTest::Correct_Queue_range(std::vector<size_t> range)
+void CheckQueueTest::Correct_Queue_range(std::vector<size_t> range, CheckQueueScheduler scheduler)
 {
-    auto small_queue = std::make_unique<Correct_Queue>(QUEUE_BATCH_SIZE, SCRIPT_CHECK_THREADS);
+    auto small_queue = std::make_unique<Correct_Queue>(QUEUE_BATCH_SIZE, SCRIPT_CHECK_THREADS, scheduler);
     // Make vChecks here to save on malloc (this test can be slow...)
     std::vector<FakeCheckCheckCompletion> vChecks;
     vChecks.reserve(9);
@@ -352,6 +352,87 @@ BOOST_AUTO_TEST_CASE(test_CheckQueue_FrozenCleanup)
 }
 
 
+/** Test that the work stealing scheduler runs every check exactly once */
+BOOST_AUTO_TEST_CASE(test_CheckQueue_WorkStealing_Correct)
+{
+    Correct_Queue_range({0, 1, 100000}, CheckQueueScheduler::WORK_STEALING);
+    std::vector<size_t> range;
+    for (size_t i = 2; i < 100000; i += 1 + m_rng.randrange(1000)) range.push_back(i);
+    Correct_Queue_range(range, CheckQueueScheduler::WORK_STEALING);
+}
+
+/** Test that large batches are split and stolen, and that no check is run twice */
+BOOST_AUTO_TEST_CASE(test_CheckQueue_WorkStealing_UniqueCheck)
+{
+    auto queue = std::make_unique<Unique_Queue>(QUEUE_BATCH_SIZE, SCRIPT_CHECK_THREADS, CheckQueueScheduler::WORK_STEALING);
+    BOOST_CHECK(queue->GetScheduler() == CheckQueueScheduler::WORK_STEALING);
+    WITH_LOCK(UniqueCheck::m, UniqueCheck::results.clear());
+    size_t COUNT = 100000;
+    size_t total = COUNT;
+    {
+        CCheckQueueControl<UniqueCheck> control(*queue);
+        while (total) {
+            size_t r = m_rng.randrange(2000);
+            std::vector<UniqueCheck> vChecks;
+            for (size_t k = 0; k < r && total; k++)
+                vChecks.emplace_back(--total);
+            control.Add(std::move(vChecks));
+        }
+    }
+    LOCK(UniqueCheck::m);
+    BOOST_REQUIRE_EQUAL(UniqueCheck::results.size(), COUNT);
+    for (size_t i = 0; i < COUNT; ++i) {
+        BOOST_REQUIRE_EQUAL(UniqueCheck::results.count(i), 1U);
+    }
+    UniqueCheck::results.clear();
+}
+
+/** Test that the work stealing scheduler reports failures and recovers from them */
+BOOST_AUTO_TEST_CASE(test_CheckQueue_WorkStealing_Failure)
+{
+    auto queue = std::make_unique<Fixed_Queue>(QUEUE_BATCH_SIZE, SCRIPT_CHECK_THREADS, CheckQueueScheduler::WORK_STEALING);
+    for (size_t i = 0; i < 1001; ++i) {
+        CCheckQueueControl<FixedCheck> control(*queue);
+        size_t remaining = i;
+        while (remaining) {
+            size_t r = m_rng.randrange(100);
+            std::vector<FixedCheck> vChecks;
+            vChecks.reserve(r);
+            for (size_t k = 0; k < r && remaining; k++, remaining--)
+                vChecks.emplace_back(remaining == 1 ? std::make_optional<int>(17 * i) : std::nullopt);
+            control.Add(std::move(vChecks));
+        }
+        auto result = control.Complete();
+        if (i > 0) {
+            BOOST_REQUIRE(result.has_value() && *result == static_cast<int>(17 * i));
+        } else {
+            BOOST_REQUIRE(!result.has_value());
+        }
+    }
+}
+
+/** Test that the work stealing scheduler frees all checks before Complete() returns */
+BOOST_AUTO_TEST_CASE(test_CheckQueue_WorkStealing_Memory)
+{
+    auto queue = std::make_unique<Memory_Queue>(QUEUE_BATCH_SIZE, SCRIPT_CHECK_THREADS, CheckQueueScheduler::WORK_STEALING);
+    for (size_t i = 0; i < 1000; ++i) {
+        size_t total = i;
+        {
+            CCheckQueueControl<MemoryCheck> control(*queue);
+            while (total) {
+                size_t r = m_rng.randrange(10);
+                std::vector<MemoryCheck> vChecks;
+                for (size_t k = 0; k < r && total; k++) {
+                    total--;
+                    vChecks.emplace_back(total == 0 || total == i || total == i/2);
+                }
+                control.Add(std::move(vChecks));
+            }
+        }
+        BOOST_REQUIRE_EQUAL(MemoryCheck::fake_allocated_memory, 0U);
+    }
+}
+
 /** Test that CCheckQueueControl is threadsafe */
 BOOST_AUTO_TEST_CASE(test_CheckQueueControl_Locks)
 {
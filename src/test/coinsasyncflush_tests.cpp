@@ -0,0 +1,110 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <coins.h>
+#include <coinsasyncflush.h>
+#include <primitives/transaction.h>
+#include <primitives/transaction_identifier.h>
+#include <test/util/setup_common.h>
+#include <txdb.h>
+#include <uint256.h>
+#include <util/byte_units.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(coinsasyncflush_tests, BasicTestingSetup)
+
+namespace {
+
+Coin MakeCoin(CAmount value)
+{
+    Coin coin;
+    coin.out.nValue = value;
+    coin.nHeight = 1;
+    return coin;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(async_flush_roundtrip)
+{
+    CCoinsViewDB db{{.path = "", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    CoinsViewAsyncFlush async{&db, /*enabled=*/true};
+    BOOST_CHECK(async.IsEnabled());
+
+    std::vector<COutPoint> outpoints;
+    for (uint32_t i{0}; i < 100; ++i) outpoints.emplace_back(Txid::FromUint256(m_rng.rand256()), i);
+
+    const uint256 block1{m_rng.rand256()};
+    {
+        CCoinsViewCache cache{&async};
+        for (size_t i{0}; i < outpoints.size(); ++i) cache.AddCoin(outpoints[i], MakeCoin(i + 1), /*possible_overwrite=*/false);
+        cache.SetBestBlock(block1);
+        cache.Flush();
+    }
+    // Reads see the flushed state, whether or not the write has completed
+    BOOST_CHECK(async.GetBestBlock() == block1);
+    for (size_t i{0}; i < outpoints.size(); ++i) {
+        BOOST_CHECK_EQUAL(async.GetCoin(outpoints[i]).value().out.nValue, CAmount(i + 1));
+    }
+
+    // Spend half of the coins in a second flush, which waits for the first one
+    const uint256 block2{m_rng.rand256()};
+    {
+        CCoinsViewCache cache{&async};
+        for (size_t i{0}; i < outpoints.size(); i += 2) BOOST_CHECK(cache.SpendCoin(outpoints[i]));
+        cache.SetBestBlock(block2);
+        cache.Flush();
+    }
+    for (size_t i{0}; i < outpoints.size(); ++i) BOOST_CHECK_EQUAL(async.HaveCoin(outpoints[i]), i % 2 == 1);
+
+    async.WaitForFlush();
+    BOOST_CHECK(!async.IsFlushing());
+    BOOST_CHECK_EQUAL(async.DynamicMemoryUsage(), 0U);
+    BOOST_CHECK(db.GetBestBlock() == block2);
+    for (size_t i{0}; i < outpoints.size(); ++i) {
+        const auto coin{db.GetCoin(outpoints[i])};
+        BOOST_CHECK_EQUAL(coin.has_value(), i % 2 == 1);
+        if (coin) BOOST_CHECK_EQUAL(coin->out.nValue, CAmount(i + 1));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(async_flush_destructor_completes_write)
+{
+    CCoinsViewDB db{{.path = "", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    const COutPoint outpoint{Txid::FromUint256(m_rng.rand256()), 0};
+    const uint256 block{m_rng.rand256()};
+    {
+        CoinsViewAsyncFlush async{&db, /*enabled=*/true};
+        CCoinsViewCache cache{&async};
+        cache.AddCoin(outpoint, MakeCoin(7), /*possible_overwrite=*/false);
+        cache.SetBestBlock(block);
+        cache.Flush();
+    }
+    BOOST_CHECK(db.GetBestBlock() == block);
+    BOOST_CHECK(db.HaveCoin(outpoint));
+}
+
+BOOST_AUTO_TEST_CASE(async_flush_disabled)
+{
+    CCoinsViewDB db{{.path = "", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    CoinsViewAsyncFlush async{&db, /*enabled=*/false};
+    BOOST_CHECK(!async.IsEnabled());
+
+    const COutPoint outpoint{Txid::FromUint256(m_rng.rand256()), 0};
+    const uint256 block{m_rng.rand256()};
+    CCoinsViewCache cache{&async};
+    cache.AddCoin(outpoint, MakeCoin(7), /*possible_overwrite=*/false);
+    cache.SetBestBlock(block);
+    cache.Flush();
+    // Written through synchronously
+    BOOST_CHECK(!async.IsFlushing());
+    BOOST_CHECK_EQUAL(async.DynamicMemoryUsage(), 0U);
+    BOOST_CHECK(db.GetBestBlock() == block);
+    BOOST_CHECK(db.HaveCoin(outpoint));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
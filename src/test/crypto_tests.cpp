@@ -849,6 +849,39 @@ BOOST_AUTO_TEST_CASE(chacha20_midblock)
     BOOST_CHECK(std::ranges::equal(std::span{block}.last(52), b3));
 }
 
+BOOST_AUTO_TEST_CASE(chacha20_multiblock)
+{
+    // Large Keystream/Crypt calls are handled several blocks at a time (4, 8 or 16 depending on
+    // the CPU). Compare them against one block at a time, including across a block counter
+    // overflow into the nonce.
+    const auto key{m_rng.randbytes<std::byte>(ChaCha20Aligned::KEYLEN)};
+    const ChaCha20Aligned::Nonce96 nonce{m_rng.rand32(), m_rng.rand64()};
+    for (const uint32_t counter : {0U, 0xfffffff0U, 0xfffffffbU}) {
+        for (size_t blocks = 1; blocks <= 40; ++blocks) {
+            const auto msg{m_rng.randbytes<std::byte>(blocks * ChaCha20Aligned::BLOCKLEN)};
+            ChaCha20Aligned multi{key}, single{key};
+            multi.Seek(nonce, counter);
+            single.Seek(nonce, counter);
+
+            std::vector<std::byte> multi_ks(msg.size()), single_ks(msg.size());
+            multi.Keystream(multi_ks);
+            for (size_t i = 0; i < blocks; ++i) {
+                single.Keystream(std::span{single_ks}.subspan(i * ChaCha20Aligned::BLOCKLEN, ChaCha20Aligned::BLOCKLEN));
+            }
+            BOOST_CHECK(multi_ks == single_ks);
+
+            // In-place encryption of the next blocks.
+            std::vector<std::byte> multi_ct{msg}, single_ct(msg.size());
+            multi.Crypt(multi_ct, multi_ct);
+            for (size_t i = 0; i < blocks; ++i) {
+                single.Crypt(std::span{msg}.subspan(i * ChaCha20Aligned::BLOCKLEN, ChaCha20Aligned::BLOCKLEN),
+                             std::span{single_ct}.subspan(i * ChaCha20Aligned::BLOCKLEN, ChaCha20Aligned::BLOCKLEN));
+            }
+            BOOST_CHECK(multi_ct == single_ct);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(poly1305_testvector)
 {
     // RFC 7539, section 2.5.2.
@@ -970,6 +1003,24 @@ BOOST_AUTO_TEST_CASE(poly1305_testvector)
                  "0e410fa9d7a40ac582e77546be9a72bb");
 }
 
+BOOST_AUTO_TEST_CASE(poly1305_multiblock)
+{
+    // Large updates may be processed several blocks at a time; feeding the same message in
+    // single 16-byte blocks must produce the same tag.
+    for (size_t len : {0, 15, 16, 64, 127, 128, 129, 1000, 4096, 4111}) {
+        const auto key{m_rng.randbytes<std::byte>(Poly1305::KEYLEN)};
+        const auto msg{m_rng.randbytes<std::byte>(len)};
+        std::vector<std::byte> tag(Poly1305::TAGLEN), expected(Poly1305::TAGLEN);
+        Poly1305{key}.Update(msg).Finalize(tag);
+        Poly1305 single{key};
+        for (size_t pos = 0; pos < len; pos += POLY1305_BLOCK_SIZE) {
+            single.Update(std::span{msg}.subspan(pos, std::min<size_t>(POLY1305_BLOCK_SIZE, len - pos)));
+        }
+        single.Finalize(expected);
+        BOOST_CHECK(tag == expected);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(chacha20poly1305_testvectors)
 {
     // Note that in our implementation, the authentication is suffixed to the ciphertext.
@@ -1087,6 +1138,26 @@ BOOST_AUTO_TEST_CASE(sha256d64)
     }
 }
 
+BOOST_AUTO_TEST_CASE(sha256dmany)
+{
+    // Enough inputs to refill the lanes of the 8-way implementation several times, covering
+    // every length up to three chunks, including those for which the padding needs an extra chunk.
+    for (size_t count : {0, 1, 3, 4, 7, 8, 9, 31, 192}) {
+        std::vector<std::vector<unsigned char>> data(count);
+        std::vector<std::span<const unsigned char>> inputs;
+        for (size_t i = 0; i < count; ++i) {
+            data[i] = m_rng.randbytes((i * 97) % count);
+            inputs.emplace_back(data[i]);
+        }
+        std::vector<unsigned char> out1(32 * count), out2(32 * count);
+        for (size_t i = 0; i < count; ++i) {
+            CHash256().Write(inputs[i]).Finalize({out1.data() + 32 * i, 32});
+        }
+        SHA256DMany(out2.data(), inputs.data(), inputs.size());
+        BOOST_CHECK(out1 == out2);
+    }
+}
+
 void CryptoTest::TestSHA3_256(const std::string& input, const std::string& output)
 {
     const auto in_bytes = ParseHex(input);
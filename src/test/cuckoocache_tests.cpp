@@ -12,6 +12,7 @@
 
 #include <deque>
 #include <mutex>
+#include <set>
 #include <shared_mutex>
 #include <thread>
 #include <vector>
@@ -49,6 +50,31 @@ BOOST_AUTO_TEST_CASE(test_cuckoocache_no_fakes)
     }
 };
 
+/* Test that for_each visits exactly the elements which were not erased.
+ */
+BOOST_AUTO_TEST_CASE(test_cuckoocache_for_each)
+{
+    CuckooCache::cache<uint256, SignatureCacheHasher> cc{};
+    cc.setup_bytes(1 << 20);
+    std::set<uint256> inserted;
+    for (int x = 0; x < 1000; ++x) {
+        const uint256 e{m_rng.rand256()};
+        inserted.insert(e);
+        cc.insert(e);
+    }
+    std::vector<uint256> visited;
+    cc.for_each([&](const uint256& e) { visited.push_back(e); });
+    BOOST_CHECK(std::set<uint256>(visited.begin(), visited.end()) == inserted);
+    // Erase half of what for_each returned
+    for (size_t i = 0; i < visited.size(); i += 2) {
+        BOOST_CHECK(cc.contains(visited[i], /*erase=*/true));
+    }
+    std::vector<uint256> remaining;
+    cc.for_each([&](const uint256& e) { remaining.push_back(e); });
+    BOOST_CHECK_EQUAL(remaining.size(), visited.size() / 2);
+    for (const uint256& e : remaining) BOOST_CHECK(cc.contains(e, false));
+};
+
 struct HitRateTest : BasicTestingSetup {
 /** This helper returns the hit rate when megabytes*load worth of entries are
  * inserted into a megabytes sized cache
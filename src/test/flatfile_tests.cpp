@@ -130,4 +130,29 @@ BOOST_AUTO_TEST_CASE(flatfile_flush)
     BOOST_CHECK_EQUAL(fs::file_size(seq.FileName(FlatFilePos(0, 1))), 1U);
 }
 
+BOOST_AUTO_TEST_CASE(flatfile_drop_cache)
+{
+    const auto data_dir = m_args.GetDataDirBase();
+    FlatFileSeq seq(data_dir, "b", 100);
+
+    std::string line1("A purely peer-to-peer version of electronic cash would allow online "
+                      "payments to be sent directly from one party to another without going "
+                      "through a financial institution.");
+    const unsigned int size(GetSerializeSize(line1));
+    {
+        AutoFile file{seq.Open(FlatFilePos(0, 0))};
+        file << LIMITED_STRING(line1, 256);
+        BOOST_REQUIRE_EQUAL(file.fclose(), 0);
+    }
+
+    // Evicting the file from the page cache keeps its data.
+    BOOST_CHECK(seq.Flush(FlatFilePos(0, size), true));
+    BOOST_CHECK(seq.DropCache(FlatFilePos(0, size)));
+    BOOST_CHECK_EQUAL(fs::file_size(seq.FileName(FlatFilePos(0, 0))), size);
+    std::string text;
+    AutoFile file{seq.Open(FlatFilePos(0, 0), true)};
+    file >> LIMITED_STRING(text, 256);
+    BOOST_CHECK_EQUAL(text, line1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
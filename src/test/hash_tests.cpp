@@ -148,6 +148,23 @@ BOOST_AUTO_TEST_CASE(siphash)
         sip288.Write(nb);
         BOOST_CHECK_EQUAL(PresaltedSipHasher(k0, k1)(x, n), sip288.Finalize());
     }
+
+    // Check that hashing many values at once matches hashing them one by one, for counts
+    // that do and do not fill a whole number of SIMD groups.
+    for (size_t count : {0, 1, 3, 4, 7, 8, 9, 31}) {
+        const PresaltedSipHasher hasher(ctx.rand64(), ctx.rand64());
+        std::vector<uint256> vals(count);
+        std::vector<const uint256*> ptrs;
+        for (auto& val : vals) {
+            val = m_rng.rand256();
+            ptrs.push_back(&val);
+        }
+        std::vector<uint64_t> out(count);
+        hasher(ptrs, out);
+        for (size_t i = 0; i < count; ++i) {
+            BOOST_CHECK_EQUAL(out[i], hasher(vals[i]));
+        }
+    }
 }
 
 BOOST_AUTO_TEST_SUITE_END()
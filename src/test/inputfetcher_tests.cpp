@@ -0,0 +1,251 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_uint256.h>
+#include <coins.h>
+#include <inputfetcher.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <primitives/transaction_identifier.h>
+#include <txdb.h>
+#include <uint256.h>
+#include <util/byte_units.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <ranges>
+
+BOOST_AUTO_TEST_SUITE(inputfetcher_tests)
+
+namespace {
+
+constexpr auto NUM_TXS{1000};
+
+CBlock CreateBlock() noexcept
+{
+    CBlock block;
+    CMutableTransaction coinbase;
+    coinbase.vin.emplace_back();
+    block.vtx.push_back(MakeTransactionRef(coinbase));
+
+    for (const auto i : std::views::iota(1, NUM_TXS)) {
+        CMutableTransaction tx;
+        Txid txid{Txid::FromUint256(ArithToUint256(i))};
+        tx.vin.emplace_back(txid, 0);
+        tx.vin.emplace_back(txid, 1);
+        block.vtx.push_back(MakeTransactionRef(tx));
+    }
+
+    return block;
+}
+
+void PopulateView(const CBlock& block, CCoinsView& view)
+{
+    CCoinsViewCache cache{&view};
+    cache.SetBestBlock(uint256::ONE);
+
+    for (const auto& tx : block.vtx | std::views::drop(1)) {
+        for (const auto& in : tx->vin) {
+            Coin coin{};
+            coin.out.nValue = 1;
+            cache.EmplaceCoinInternalDANGER(COutPoint{in.prevout}, std::move(coin));
+        }
+    }
+
+    cache.Flush();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(fetch_inputs)
+{
+    const auto block{CreateBlock()};
+    CCoinsViewDB db{{.path = "", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    PopulateView(block, db);
+    CCoinsViewCache cache{&db};
+
+    InputFetcher fetcher{/*worker_threads_num=*/3};
+    BOOST_CHECK(fetcher.HasThreads());
+    BOOST_CHECK_EQUAL(fetcher.FetchInputs(cache, db, block), 2 * (NUM_TXS - 1));
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 2 * (NUM_TXS - 1));
+    // Prefetched coins are never written back to the db
+    BOOST_CHECK_EQUAL(cache.GetDirtyCount(), 0);
+    for (const auto& tx : block.vtx | std::views::drop(1)) {
+        for (const auto& in : tx->vin) {
+            BOOST_CHECK(cache.HaveCoinInCache(in.prevout));
+            BOOST_CHECK_EQUAL(cache.AccessCoin(in.prevout).out.nValue, 1);
+        }
+    }
+    cache.SanityCheck();
+
+    // Uncaching removes the prefetched coins again, e.g. after a failed connect
+    fetcher.UncacheInputs(cache);
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 0);
+    BOOST_CHECK_EQUAL(fetcher.FetchInputs(cache, db, block), 2 * (NUM_TXS - 1));
+
+    // A second call finds everything in the cache already
+    BOOST_CHECK_EQUAL(fetcher.FetchInputs(cache, db, block), 0);
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 2 * (NUM_TXS - 1));
+}
+
+BOOST_AUTO_TEST_CASE(fetch_inputs_keeps_cached_coins)
+{
+    const auto block{CreateBlock()};
+    CCoinsViewDB db{{.path = "", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    PopulateView(block, db);
+    CCoinsViewCache cache{&db};
+
+    // Spend one coin and modify another one in the cache without flushing to the db
+    const auto& spent{block.vtx[1]->vin[0].prevout};
+    const auto& modified{block.vtx[2]->vin[0].prevout};
+    BOOST_CHECK(cache.SpendCoin(spent));
+    Coin coin{};
+    coin.out.nValue = 2;
+    cache.AddCoin(modified, std::move(coin), /*possible_overwrite=*/true);
+
+    InputFetcher fetcher{/*worker_threads_num=*/2};
+    fetcher.FetchInputs(cache, db, block);
+    BOOST_CHECK(!cache.HaveCoin(spent));
+    BOOST_CHECK_EQUAL(cache.AccessCoin(modified).out.nValue, 2);
+    BOOST_CHECK_EQUAL(cache.GetDirtyCount(), 2);
+    cache.SanityCheck();
+}
+
+BOOST_AUTO_TEST_CASE(fetch_skips_outputs_created_in_block)
+{
+    CBlock block;
+    CMutableTransaction coinbase;
+    coinbase.vin.emplace_back();
+    block.vtx.push_back(MakeTransactionRef(coinbase));
+    CMutableTransaction parent;
+    parent.vin.emplace_back(Txid::FromUint256(uint256::ONE), 0);
+    parent.vout.resize(1);
+    block.vtx.push_back(MakeTransactionRef(parent));
+    CMutableTransaction child;
+    child.vin.emplace_back(block.vtx[1]->GetHash(), 0);
+    block.vtx.push_back(MakeTransactionRef(child));
+
+    CCoinsViewDB db{{.path = "", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    PopulateView(block, db);
+    CCoinsViewCache cache{&db};
+
+    InputFetcher fetcher{/*worker_threads_num=*/2};
+    BOOST_CHECK_EQUAL(fetcher.FetchInputs(cache, db, block), 1);
+    BOOST_CHECK(cache.HaveCoinInCache(block.vtx[1]->vin[0].prevout));
+    BOOST_CHECK(!cache.HaveCoinInCache(block.vtx[2]->vin[0].prevout));
+}
+
+BOOST_AUTO_TEST_CASE(fetch_next_inputs)
+{
+    const auto parent{CreateBlock()};
+    CBlock next;
+    CMutableTransaction coinbase;
+    coinbase.vin.emplace_back();
+    next.vtx.push_back(MakeTransactionRef(coinbase));
+    CMutableTransaction tx;
+    // A coin in the database, a coin also spent by the parent, and an output of the parent
+    tx.vin.emplace_back(Txid::FromUint256(ArithToUint256(NUM_TXS + 1)), 0);
+    tx.vin.emplace_back(parent.vtx[1]->vin[0].prevout);
+    tx.vin.emplace_back(parent.vtx[2]->GetHash(), 0);
+    next.vtx.push_back(MakeTransactionRef(tx));
+
+    CCoinsViewDB db{{.path = "", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    PopulateView(parent, db);
+    {
+        CCoinsViewCache cache{&db};
+        cache.SetBestBlock(uint256::ONE);
+        Coin coin{};
+        coin.out.nValue = 3;
+        cache.EmplaceCoinInternalDANGER(COutPoint{next.vtx[1]->vin[0].prevout}, std::move(coin));
+        cache.Flush();
+    }
+    CCoinsViewCache cache{&db};
+
+    InputFetcher fetcher{/*worker_threads_num=*/2};
+    fetcher.FetchNextInputs(cache, db, parent, std::make_shared<const CBlock>(next));
+    fetcher.WaitForNextInputs();
+
+    // Nothing is handed out for another block, or before the cache is at the parent
+    BOOST_CHECK(!fetcher.UseNextInputs(cache, parent.GetHash()).first);
+    fetcher.FetchNextInputs(cache, db, parent, std::make_shared<const CBlock>(next));
+    BOOST_CHECK(!fetcher.UseNextInputs(cache, next.GetHash()).first);
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 0);
+
+    fetcher.FetchNextInputs(cache, db, parent, std::make_shared<const CBlock>(next));
+    cache.SetBestBlock(parent.GetHash());
+    const auto [block, fetched]{fetcher.UseNextInputs(cache, next.GetHash())};
+    BOOST_REQUIRE(block);
+    BOOST_CHECK(block->GetHash() == next.GetHash());
+    // Only the coin untouched by the parent was fetched
+    BOOST_CHECK_EQUAL(fetched, 1);
+    BOOST_CHECK(cache.HaveCoinInCache(next.vtx[1]->vin[0].prevout));
+    BOOST_CHECK(!cache.HaveCoinInCache(next.vtx[1]->vin[1].prevout));
+    BOOST_CHECK_EQUAL(cache.GetDirtyCount(), 0);
+
+    // The fetch is consumed
+    BOOST_CHECK(!fetcher.UseNextInputs(cache, next.GetHash()).first);
+
+    // Discarded fetches are never used
+    cache.Uncache(next.vtx[1]->vin[0].prevout);
+    fetcher.FetchNextInputs(cache, db, parent, std::make_shared<const CBlock>(next));
+    fetcher.DiscardNextInputs();
+    BOOST_CHECK(!fetcher.UseNextInputs(cache, next.GetHash()).first);
+    BOOST_CHECK(!cache.HaveCoinInCache(next.vtx[1]->vin[0].prevout));
+}
+
+BOOST_AUTO_TEST_CASE(fetch_next_inputs_skips_spent_entries)
+{
+    const auto parent{CreateBlock()};
+    // A coin spent by an earlier block, whose spend has not been flushed yet
+    const COutPoint spent{Txid::FromUint256(ArithToUint256(NUM_TXS + 2)), 0};
+    CBlock next;
+    CMutableTransaction coinbase;
+    coinbase.vin.emplace_back();
+    next.vtx.push_back(MakeTransactionRef(coinbase));
+    CMutableTransaction tx;
+    tx.vin.emplace_back(spent);
+    next.vtx.push_back(MakeTransactionRef(tx));
+
+    CCoinsViewDB db{{.path = "", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    PopulateView(parent, db);
+    {
+        CCoinsViewCache cache{&db};
+        cache.SetBestBlock(uint256::ONE);
+        Coin coin{};
+        coin.out.nValue = 1;
+        cache.EmplaceCoinInternalDANGER(COutPoint{spent}, std::move(coin));
+        cache.Flush();
+    }
+    CCoinsViewCache cache{&db};
+    BOOST_CHECK(cache.SpendCoin(spent));
+
+    InputFetcher fetcher{/*worker_threads_num=*/2};
+    fetcher.FetchNextInputs(cache, db, parent, std::make_shared<const CBlock>(next));
+    fetcher.WaitForNextInputs();
+
+    // Writing the spend drops the spent entry, so the coin must not come back from the fetch
+    cache.SetBestBlock(parent.GetHash());
+    cache.Flush();
+    const auto [block, fetched]{fetcher.UseNextInputs(cache, next.GetHash())};
+    BOOST_REQUIRE(block);
+    BOOST_CHECK_EQUAL(fetched, 0);
+    BOOST_CHECK(!cache.HaveInputs(CTransaction{tx}));
+}
+
+BOOST_AUTO_TEST_CASE(fetch_disabled)
+{
+    const auto block{CreateBlock()};
+    CCoinsViewDB db{{.path = "", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    PopulateView(block, db);
+    CCoinsViewCache cache{&db};
+
+    InputFetcher fetcher{/*worker_threads_num=*/0};
+    BOOST_CHECK(!fetcher.HasThreads());
+    BOOST_CHECK_EQUAL(fetcher.FetchInputs(cache, db, block), 0);
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1340,6 +1340,38 @@ public:
 
 } // namespace
 
+BOOST_AUTO_TEST_CASE(v1transport_next_bytes_to_send)
+{
+    V1Transport transport{0};
+    const auto payload{m_rng.randbytes<uint8_t>(100)};
+    CSerializedNetMsg msg;
+    msg.m_type = NetMsgType::PING;
+    msg.data = payload;
+    BOOST_REQUIRE(transport.SetMessageToSend(msg));
+
+    // While the header is being sent, the payload is available to be sent along with it.
+    size_t header_size;
+    {
+        const auto& [header, more, msg_type] = transport.GetBytesToSend(/*have_next_message=*/false);
+        header_size = header.size();
+        BOOST_CHECK_EQUAL(header_size, CMessageHeader::HEADER_SIZE);
+        BOOST_CHECK(more);
+        BOOST_CHECK_EQUAL(msg_type, NetMsgType::PING);
+    }
+    BOOST_CHECK(std::ranges::equal(transport.GetNextBytesToSend(), payload));
+
+    // Mark the header and a part of the payload as sent at once.
+    transport.MarkBytesSent(header_size + 40);
+    {
+        const auto& [rest, more, msg_type] = transport.GetBytesToSend(/*have_next_message=*/false);
+        BOOST_CHECK(std::ranges::equal(rest, std::span{payload}.subspan(40)));
+        BOOST_CHECK(!more);
+    }
+    BOOST_CHECK(transport.GetNextBytesToSend().empty());
+    transport.MarkBytesSent(payload.size() - 40);
+    BOOST_CHECK(std::get<0>(transport.GetBytesToSend(/*have_next_message=*/false)).empty());
+}
+
 BOOST_AUTO_TEST_CASE(v2transport_test)
 {
     // A mostly normal scenario, testing a transport in initiator mode.
@@ -3,12 +3,20 @@
 // file COPYING or https://www.opensource.org/licenses/mit-license.php.
 
 #include <chainparams.h>
-#include <node/miner.h>
+#include <net.h>
 #include <net_processing.h>
+#include <netmessagemaker.h>
+#include <node/miner.h>
 #include <pow.h>
+#include <protocol.h>
+#include <sync.h>
+#include <test/util/net.h>
 #include <test/util/setup_common.h>
 #include <validation.h>
 
+#include <string>
+#include <vector>
+
 #include <boost/test/unit_test.hpp>
 
 BOOST_FIXTURE_TEST_SUITE(peerman_tests, RegTestingSetup)
@@ -75,4 +83,56 @@ BOOST_AUTO_TEST_CASE(connections_desirable_service_flags)
     BOOST_CHECK(peerman->GetDesirableServiceFlags(peer_flags) == ServiceFlags(NODE_NETWORK | NODE_WITNESS));
 }
 
+BOOST_AUTO_TEST_CASE(getdata_workers_keep_response_order)
+{
+    LOCK(NetEventsInterface::g_msgproc_mutex);
+    auto& connman{static_cast<ConnmanTestMsg&>(*m_node.connman)};
+    PeerManager::Options opts;
+    opts.getdata_threads = 2;
+    std::unique_ptr<PeerManager> peerman = PeerManager::make(connman, *m_node.addrman, nullptr, *m_node.chainman, *m_node.mempool, *m_node.warnings, opts);
+    connman.SetMsgProc(peerman.get());
+
+    CNode node{/*id=*/0,
+               /*sock=*/nullptr,
+               CAddress{},
+               /*nKeyedNetGroupIn=*/0,
+               /*nLocalHostNonceIn=*/0,
+               CAddress{},
+               /*addrNameIn=*/"",
+               ConnectionType::INBOUND,
+               /*inbound_onion=*/false,
+               /*network_key=*/0};
+    connman.Handshake(node,
+                      /*successfully_connected=*/true,
+                      /*remote_services=*/ServiceFlags(NODE_NETWORK | NODE_WITNESS),
+                      /*local_services=*/ServiceFlags(NODE_NETWORK | NODE_WITNESS),
+                      /*version=*/PROTOCOL_VERSION,
+                      /*relay_txs=*/true);
+    connman.FlushSendBuffer(node);
+
+    Mutex sent_mutex;
+    std::vector<std::string> sent;
+    const auto capture_orig{CaptureMessage};
+    CaptureMessage = [&](const CAddress&, const std::string& msg_type, std::span<const unsigned char>, bool is_incoming) {
+        if (!is_incoming) WITH_LOCK(sent_mutex, sent.push_back(msg_type));
+    };
+    connman.SetCaptureMessages(true);
+
+    // Both blocks are read from disk by the peer's getdata worker. The pong must follow them.
+    const uint256 genesis{m_node.chainman->GetParams().GenesisBlock().GetHash()};
+    (void)connman.ReceiveMsgFrom(node, NetMsg::Make(NetMsgType::GETDATA, std::vector<CInv>{{MSG_WITNESS_BLOCK, genesis}, {MSG_BLOCK, genesis}}));
+    (void)connman.ReceiveMsgFrom(node, NetMsg::Make(NetMsgType::PING, uint64_t{42}));
+    for (int i{0}; i < 1000 && WITH_LOCK(sent_mutex, return sent.size()) < 3; ++i) {
+        node.fPauseSend = false;
+        if (!connman.ProcessMessagesOnce(node)) UninterruptibleSleep(1ms);
+    }
+    BOOST_CHECK(WITH_LOCK(sent_mutex, return sent) == (std::vector<std::string>{NetMsgType::BLOCK, NetMsgType::BLOCK, NetMsgType::PONG}));
+    BOOST_CHECK(!node.fDisconnect);
+
+    peerman->FinalizeNode(node);
+    connman.SetCaptureMessages(false);
+    CaptureMessage = capture_orig;
+    connman.SetMsgProc(m_node.peerman.get());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
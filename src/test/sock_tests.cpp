@@ -13,6 +13,7 @@
 
 #include <cassert>
 #include <thread>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -126,6 +127,22 @@ BOOST_AUTO_TEST_CASE(send_and_receive)
     BOOST_CHECK(SocketIsClosed(s[1]));
 }
 
+BOOST_AUTO_TEST_CASE(send_vectored)
+{
+    int s[2];
+    CreateSocketPair(s);
+    Sock sender(s[0]);
+    Sock receiver(s[1]);
+
+    const std::vector<unsigned char> header{'a', 'b'};
+    const std::vector<unsigned char> payload{'c', 'd', 'e'};
+    const std::span<const unsigned char> bufs[]{header, payload};
+    BOOST_REQUIRE_EQUAL(sender.SendV(bufs, 0), 5);
+    char recv_buf[10];
+    BOOST_REQUIRE_EQUAL(receiver.Recv(recv_buf, sizeof(recv_buf), 0), 5);
+    BOOST_CHECK_EQUAL(strncmp(recv_buf, "abcde", 5), 0);
+}
+
 BOOST_AUTO_TEST_CASE(wait)
 {
     int s[2];
@@ -141,6 +158,40 @@ BOOST_AUTO_TEST_CASE(wait)
     waiter.join();
 }
 
+BOOST_AUTO_TEST_CASE(event_poller)
+{
+    Sock::EventPoller poller;
+    if (!poller.IsAvailable()) return;
+
+    int s[2];
+    CreateSocketPair(s);
+    auto sock0{std::make_shared<Sock>(s[0])};
+    auto sock1{std::make_shared<Sock>(s[1])};
+
+    // Nothing to wait for.
+    Sock::EventsPerSock events_per_sock;
+    BOOST_CHECK(!poller.WaitMany(0ms, events_per_sock));
+
+    // Writable, but nothing to read yet.
+    events_per_sock.emplace(sock0, Sock::Events{Sock::RECV | Sock::SEND});
+    BOOST_REQUIRE(poller.WaitMany(0ms, events_per_sock));
+    BOOST_CHECK_EQUAL(events_per_sock.at(sock0).occurred, Sock::SEND);
+
+    // The registration is updated when the requested events change.
+    BOOST_REQUIRE_EQUAL(sock1->Send("a", 1, 0), 1);
+    events_per_sock.at(sock0) = Sock::Events{Sock::RECV};
+    BOOST_REQUIRE(poller.WaitMany(0ms, events_per_sock));
+    BOOST_CHECK_EQUAL(events_per_sock.at(sock0).occurred, Sock::RECV);
+
+    // A socket that is no longer waited for is released and closed once the caller drops it.
+    events_per_sock.clear();
+    events_per_sock.emplace(sock1, Sock::Events{Sock::RECV});
+    sock0.reset();
+    BOOST_REQUIRE(poller.WaitMany(0ms, events_per_sock));
+    BOOST_CHECK(SocketIsClosed(s[0]));
+    BOOST_CHECK(events_per_sock.at(sock1).occurred & Sock::RECV);
+}
+
 BOOST_AUTO_TEST_CASE(recv_until_terminator_limit)
 {
     constexpr auto timeout = 1min; // High enough so that it is never hit.
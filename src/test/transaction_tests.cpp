@@ -14,9 +14,11 @@
 #include <consensus/tx_verify.h>
 #include <consensus/validation.h>
 #include <core_io.h>
+#include <crypto/sha256.h>
 #include <key.h>
 #include <policy/policy.h>
 #include <policy/settings.h>
+#include <primitives/block.h>
 #include <primitives/transaction_identifier.h>
 #include <script/interpreter.h>
 #include <script/script.h>
@@ -1164,6 +1166,61 @@ BOOST_AUTO_TEST_CASE(getvalueout_out_of_range_throws)
     BOOST_CHECK_EXCEPTION(tx.GetValueOut(), std::runtime_error, HasReason("GetValueOut: value out of range"));
 }
 
+BOOST_AUTO_TEST_CASE(make_transaction_refs)
+{
+    std::vector<CMutableTransaction> mtxs(50);
+    for (size_t i{0}; i < mtxs.size(); ++i) {
+        auto& mtx{mtxs[i]};
+        mtx.vin.resize(1 + m_rng.randrange(3));
+        for (auto& in : mtx.vin) {
+            in.prevout = COutPoint{Txid::FromUint256(m_rng.rand256()), 0};
+            const auto script_sig{m_rng.randbytes(m_rng.randrange(100))};
+            in.scriptSig = CScript(script_sig.begin(), script_sig.end());
+            // Give every other transaction a witness, so its wtxid differs from its txid.
+            if (i % 2) in.scriptWitness.stack.push_back(m_rng.randbytes(1 + m_rng.randrange(100)));
+        }
+        mtx.vout.emplace_back(i, CScript() << OP_TRUE);
+    }
+    const std::vector<CMutableTransaction> copies{mtxs};
+    const auto txs{MakeTransactionRefs(std::move(mtxs))};
+    BOOST_REQUIRE_EQUAL(txs.size(), copies.size());
+    for (size_t i{0}; i < txs.size(); ++i) {
+        const CTransaction expected{copies[i]};
+        BOOST_CHECK(txs[i]->GetHash() == expected.GetHash());
+        BOOST_CHECK(txs[i]->GetWitnessHash() == expected.GetWitnessHash());
+        BOOST_CHECK_EQUAL(txs[i]->HasWitness(), i % 2 == 1);
+    }
+    BOOST_CHECK(MakeTransactionRefs({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(transactions_formatter)
+{
+    CBlock block;
+    for (size_t i{0}; i < 20; ++i) {
+        CMutableTransaction mtx;
+        mtx.vin.emplace_back(COutPoint{Txid::FromUint256(m_rng.rand256()), 0});
+        if (i % 2) mtx.vin[0].scriptWitness.stack.push_back(m_rng.randbytes(1 + m_rng.randrange(100)));
+        mtx.vout.emplace_back(i, CScript() << OP_TRUE);
+        block.vtx.push_back(MakeTransactionRef(std::move(mtx)));
+    }
+    DataStream stream;
+    stream << TX_WITH_WITNESS(block);
+
+    // Blocks deserialize to the same transactions whether or not their hashes are batched.
+    for (const auto use_implementation : {sha256_implementation::STANDARD, sha256_implementation::USE_ALL}) {
+        SHA256AutoDetect(use_implementation);
+        if (use_implementation == sha256_implementation::STANDARD) BOOST_CHECK(!CanBatchTransactionHashes());
+        CBlock read;
+        DataStream{stream} >> TX_WITH_WITNESS(read);
+        BOOST_REQUIRE_EQUAL(read.vtx.size(), block.vtx.size());
+        for (size_t i{0}; i < read.vtx.size(); ++i) {
+            BOOST_CHECK(read.vtx[i]->GetHash() == block.vtx[i]->GetHash());
+            BOOST_CHECK(read.vtx[i]->GetWitnessHash() == block.vtx[i]->GetWitnessHash());
+        }
+    }
+    SHA256AutoDetect();
+}
+
 /** Sanity check the return value of SpendsNonAnchorWitnessProg for various output types. */
 BOOST_AUTO_TEST_CASE(spends_witness_prog)
 {
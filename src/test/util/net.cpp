@@ -170,6 +170,13 @@ ZeroSock::~ZeroSock() { m_socket = INVALID_SOCKET; }
 
 ssize_t ZeroSock::Send(const void*, size_t len, int) const { return len; }
 
+ssize_t ZeroSock::SendV(std::span<const std::span<const unsigned char>> bufs, int) const
+{
+    ssize_t len{0};
+    for (const auto& buf : bufs) len += buf.size();
+    return len;
+}
+
 ssize_t ZeroSock::Recv(void* buf, size_t len, int flags) const
 {
     memset(buf, 0x0, len);
@@ -367,6 +374,16 @@ ssize_t DynSock::Send(const void* buf, size_t len, int) const
     return len;
 }
 
+ssize_t DynSock::SendV(std::span<const std::span<const unsigned char>> bufs, int) const
+{
+    ssize_t len{0};
+    for (const auto& buf : bufs) {
+        m_pipes->send.PushBytes(buf.data(), buf.size());
+        len += buf.size();
+    }
+    return len;
+}
+
 std::unique_ptr<Sock> DynSock::Accept(sockaddr* addr, socklen_t* addr_len) const
 {
     ZeroSock::Accept(addr, addr_len);
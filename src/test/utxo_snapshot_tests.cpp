@@ -0,0 +1,252 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <coins.h>
+#include <kernel/coinstats.h>
+#include <node/utxo_snapshot.h>
+#include <primitives/transaction.h>
+#include <random.h>
+#include <serialize.h>
+#include <streams.h>
+#include <test/util/setup_common.h>
+#include <txdb.h>
+#include <uint256.h>
+#include <util/byte_units.h>
+#include <util/fs.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using node::SnapshotChunkInfo;
+using node::SnapshotChunkWriter;
+using node::SnapshotCoins;
+using node::SnapshotCoinsReader;
+using node::SnapshotMetadata;
+
+BOOST_FIXTURE_TEST_SUITE(utxo_snapshot_tests, TestChain100Setup)
+
+namespace {
+
+//! Write coins in the snapshot format, grouping consecutive coins of the same txid.
+void WriteCoins(const fs::path& path, const SnapshotCoins& coins, bool trailing_byte = false)
+{
+    AutoFile file{fsbridge::fopen(path, "wb")};
+    for (size_t i{0}; i < coins.size();) {
+        size_t j{i};
+        while (j < coins.size() && coins[j].first.hash == coins[i].first.hash) ++j;
+        file << coins[i].first.hash;
+        WriteCompactSize(file, j - i);
+        for (; i < j; ++i) {
+            WriteCompactSize(file, coins[i].first.n);
+            file << coins[i].second;
+        }
+    }
+    if (trailing_byte) file << uint8_t{0};
+    BOOST_REQUIRE_EQUAL(file.fclose(), 0);
+}
+
+struct ReadResult {
+    SnapshotCoins coins;
+    std::optional<std::string> error;
+    std::optional<uint256> hash;
+};
+
+bool Equal(const SnapshotCoins& a, const SnapshotCoins& b)
+{
+    return std::ranges::equal(a, b, [](const auto& x, const auto& y) {
+        return x.first == y.first && x.second.out == y.second.out &&
+               x.second.nHeight == y.second.nHeight && x.second.fCoinBase == y.second.fCoinBase;
+    });
+}
+
+ReadResult ReadCoins(const fs::path& path, uint64_t coins_count, int base_height, uint16_t version = SnapshotMetadata::VERSION)
+{
+    AutoFile file{fsbridge::fopen(path, "rb")};
+    SnapshotCoinsReader reader{file, coins_count, base_height, version};
+    ReadResult result;
+    while (auto batch{reader.Next()}) {
+        std::ranges::move(*batch, std::back_inserter(result.coins));
+    }
+    result.error = reader.GetError();
+    result.hash = reader.HashSerialized();
+    return result;
+}
+
+//! Random coins for several batches, with a few outputs per txid, in database order.
+SnapshotCoins RandomCoins(FastRandomContext& rng, int max_height)
+{
+    std::map<COutPoint, Coin> sorted;
+    while (sorted.size() < 2 * SnapshotCoinsReader::BATCH_SIZE + 123) {
+        const Txid txid{Txid::FromUint256(rng.rand256())};
+        for (uint32_t n{0}, outputs{1 + rng.randrange<uint32_t>(4)}; n < outputs; ++n) {
+            Coin coin;
+            coin.out.nValue = 1 + rng.randrange<CAmount>(1000);
+            coin.out.scriptPubKey.resize(rng.randrange(40));
+            coin.nHeight = rng.randrange(max_height + 1);
+            coin.fCoinBase = rng.randbool();
+            sorted.emplace(COutPoint{txid, 3 * n + 1}, std::move(coin));
+        }
+    }
+    return {sorted.begin(), sorted.end()};
+}
+
+void AddCoins(CCoinsViewDB& db, const SnapshotCoins& coins, const uint256& best_block)
+{
+    CCoinsViewCache cache{&db};
+    for (const auto& [outpoint, coin] : coins) cache.AddCoin(outpoint, Coin{coin}, /*possible_overwrite=*/false);
+    cache.SetBestBlock(best_block);
+    cache.Flush();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(snapshot_coins_reader)
+{
+    const int height{WITH_LOCK(::cs_main, return m_node.chainman->ActiveHeight())};
+    const uint256 tip{WITH_LOCK(::cs_main, return m_node.chainman->ActiveTip()->GetBlockHash())};
+    const SnapshotCoins coins{RandomCoins(m_rng, height)};
+
+    // The hash of the coins as they are read from a database holding them.
+    CCoinsViewDB db{{.path = "", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    AddCoins(db, coins, tip);
+    const auto stats{kernel::ComputeUTXOStats(kernel::CoinStatsHashType::HASH_SERIALIZED, &db, m_node.chainman->m_blockman)};
+    BOOST_REQUIRE(stats);
+
+    const fs::path path{m_args.GetDataDirBase() / "coins.dat"};
+
+    // In database order, the coins are hashed as they are read.
+    WriteCoins(path, coins);
+    {
+        const auto result{ReadCoins(path, coins.size(), height)};
+        BOOST_CHECK(!result.error);
+        BOOST_CHECK(Equal(result.coins, coins));
+        BOOST_REQUIRE(result.hash);
+        BOOST_CHECK_EQUAL(result.hash->ToString(), stats->hashSerialized.ToString());
+    }
+
+    // In any other order, all coins are still returned but not hashed.
+    SnapshotCoins reversed(coins.rbegin(), coins.rend());
+    WriteCoins(path, reversed);
+    {
+        const auto result{ReadCoins(path, reversed.size(), height)};
+        BOOST_CHECK(!result.error);
+        BOOST_CHECK(Equal(result.coins, reversed));
+        BOOST_CHECK(!result.hash);
+    }
+
+    // Coins above the base height are rejected.
+    WriteCoins(path, coins);
+    {
+        const auto result{ReadCoins(path, coins.size(), height - 1)};
+        BOOST_REQUIRE(result.error);
+        BOOST_CHECK(result.error->starts_with("Bad snapshot data after deserializing"));
+        BOOST_CHECK(!result.hash);
+    }
+
+    // Fewer coins in the file than announced.
+    {
+        const auto result{ReadCoins(path, coins.size() + 1, height)};
+        BOOST_REQUIRE(result.error);
+        BOOST_CHECK_EQUAL(*result.error, strprintf("Bad snapshot format or truncated snapshot after deserializing %d coins", coins.size()));
+        BOOST_CHECK_EQUAL(result.coins.size(), coins.size());
+    }
+
+    // Bytes left over after the announced coins.
+    WriteCoins(path, coins, /*trailing_byte=*/true);
+    {
+        const auto result{ReadCoins(path, coins.size(), height)};
+        BOOST_REQUIRE(result.error);
+        BOOST_CHECK_EQUAL(*result.error, strprintf("Bad snapshot - coins left over after deserializing %d coins", coins.size()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_chunk_writer)
+{
+    const int height{WITH_LOCK(::cs_main, return m_node.chainman->ActiveHeight())};
+    const uint256 tip{WITH_LOCK(::cs_main, return m_node.chainman->ActiveTip()->GetBlockHash())};
+    const SnapshotCoins coins{RandomCoins(m_rng, height)};
+
+    CCoinsViewDB db{{.path = "", .cache_bytes = 1_MiB, .memory_only = true}, {}};
+    AddCoins(db, coins, tip);
+    const auto stats{kernel::ComputeUTXOStats(kernel::CoinStatsHashType::HASH_SERIALIZED, &db, m_node.chainman->m_blockman)};
+    BOOST_REQUIRE(stats);
+
+    const fs::path path{m_args.GetDataDirBase() / "coins.dat"};
+    {
+        SnapshotChunkWriter writer{db};
+        // Coins written after the cursors were opened are not part of the snapshot.
+        AddCoins(db, {{COutPoint{Txid::FromUint256(m_rng.rand256()), 0}, coins.front().second}}, tip);
+        AutoFile file{fsbridge::fopen(path, "wb")};
+        BOOST_CHECK_EQUAL(writer.Write(file, /*threads=*/3), coins.size());
+        BOOST_REQUIRE_EQUAL(file.fclose(), 0);
+    }
+
+    // The chunks are written in database order, so the coins are hashed as they are read.
+    {
+        const auto result{ReadCoins(path, coins.size(), height, SnapshotMetadata::CHUNKED_VERSION)};
+        BOOST_CHECK(!result.error);
+        BOOST_CHECK(Equal(result.coins, coins));
+        BOOST_REQUIRE(result.hash);
+        BOOST_CHECK_EQUAL(result.hash->ToString(), stats->hashSerialized.ToString());
+    }
+
+    // The index lists chunks of whole txids, adding up to all coins.
+    std::vector<SnapshotChunkInfo> index;
+    {
+        AutoFile file{fsbridge::fopen(path, "rb")};
+        file.seek(-8, SEEK_END);
+        uint64_t index_offset;
+        file >> index_offset;
+        file.seek(index_offset, SEEK_SET);
+        file >> index;
+    }
+    BOOST_CHECK_GT(index.size(), 1U);
+    uint64_t indexed_coins{0};
+    for (const auto& chunk : index) indexed_coins += chunk.coins_count;
+    BOOST_CHECK_EQUAL(indexed_coins, coins.size());
+
+    // A corrupted chunk is detected by its checksum.
+    {
+        AutoFile file{fsbridge::fopen(path, "r+b")};
+        file.seek(index[1].offset + 20, SEEK_SET);
+        std::byte b;
+        file >> b;
+        file.seek(index[1].offset + 20, SEEK_SET);
+        file << (b ^ std::byte{1});
+        BOOST_REQUIRE_EQUAL(file.fclose(), 0);
+    }
+    {
+        const auto result{ReadCoins(path, coins.size(), height, SnapshotMetadata::CHUNKED_VERSION)};
+        BOOST_REQUIRE(result.error);
+        BOOST_CHECK_EQUAL(*result.error, strprintf("Bad snapshot - checksum mismatch in chunk 1 after deserializing %d coins", index[0].coins_count));
+        BOOST_CHECK_EQUAL(result.coins.size(), index[0].coins_count);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(snapshot_coins_reader_early_destruction)
+{
+    SnapshotCoins coins;
+    for (size_t i{0}; i < SnapshotCoinsReader::BATCH_SIZE * (SnapshotCoinsReader::MAX_QUEUED_BATCHES + 2); ++i) {
+        Coin coin;
+        coin.out.nValue = 1;
+        coin.nHeight = 1;
+        coins.emplace_back(COutPoint{Txid::FromUint256(m_rng.rand256()), 0}, std::move(coin));
+    }
+    const fs::path path{m_args.GetDataDirBase() / "coins.dat"};
+    WriteCoins(path, coins);
+
+    // The decoding thread blocks on a full queue, and must be stopped by the destructor.
+    AutoFile file{fsbridge::fopen(path, "rb")};
+    SnapshotCoinsReader reader{file, coins.size(), /*base_height=*/1};
+    BOOST_CHECK(reader.Next());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
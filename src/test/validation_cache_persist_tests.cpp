@@ -0,0 +1,82 @@
+// Copyright (c) The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/validation_cache_persist.h>
+#include <script/sigcache.h>
+#include <streams.h>
+#include <sync.h>
+#include <test/util/setup_common.h>
+#include <uint256.h>
+#include <util/byte_units.h>
+#include <util/fs.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using node::DumpValidationCache;
+using node::LoadValidationCache;
+
+BOOST_FIXTURE_TEST_SUITE(validation_cache_persist_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(dump_load_roundtrip)
+{
+    const fs::path path{m_args.GetDataDirBase() / "validationcache.dat"};
+
+    ValidationCache original{1_MiB, 1_MiB};
+    std::vector<uint256> signature_entries, script_execution_entries;
+    for (int i{0}; i < 100; ++i) {
+        signature_entries.push_back(m_rng.rand256());
+        original.m_signature_cache.Set(signature_entries.back());
+        script_execution_entries.push_back(m_rng.rand256());
+        WITH_LOCK(cs_main, original.m_script_execution_cache.insert(script_execution_entries.back()));
+    }
+    BOOST_CHECK_EQUAL(original.m_signature_cache.GetEntries().size(), signature_entries.size());
+    BOOST_REQUIRE(DumpValidationCache(original, path, fsbridge::fopen, /*skip_file_commit=*/true));
+
+    ValidationCache restored{1_MiB, 1_MiB};
+    BOOST_CHECK(restored.m_signature_cache.GetNonce() != original.m_signature_cache.GetNonce());
+    BOOST_CHECK(restored.ScriptExecutionCacheNonce() != original.ScriptExecutionCacheNonce());
+    BOOST_REQUIRE(LoadValidationCache(restored, path));
+
+    // The salts are restored along with the entries
+    BOOST_CHECK(restored.m_signature_cache.GetNonce() == original.m_signature_cache.GetNonce());
+    BOOST_CHECK(restored.ScriptExecutionCacheNonce() == original.ScriptExecutionCacheNonce());
+    LOCK(cs_main);
+    for (const uint256& entry : signature_entries) BOOST_CHECK(restored.m_signature_cache.Get(entry, /*erase=*/false));
+    for (const uint256& entry : script_execution_entries) BOOST_CHECK(restored.m_script_execution_cache.contains(entry, /*erase=*/false));
+}
+
+BOOST_AUTO_TEST_CASE(load_corrupted)
+{
+    const fs::path path{m_args.GetDataDirBase() / "validationcache.dat"};
+
+    ValidationCache original{1_MiB, 1_MiB};
+    original.m_signature_cache.Set(m_rng.rand256());
+    BOOST_REQUIRE(DumpValidationCache(original, path, fsbridge::fopen, /*skip_file_commit=*/true));
+
+    // Flip a bit of the signature cache salt
+    {
+        AutoFile file{fsbridge::fopen(path, "r+b")};
+        const int64_t pos{sizeof(uint64_t) + sizeof(int32_t)};
+        file.seek(pos, SEEK_SET);
+        uint8_t byte;
+        file >> byte;
+        file.seek(pos, SEEK_SET);
+        file << uint8_t(byte ^ 1);
+        BOOST_REQUIRE_EQUAL(file.fclose(), 0);
+    }
+
+    ValidationCache restored{1_MiB, 1_MiB};
+    const uint256 nonce{restored.m_signature_cache.GetNonce()};
+    BOOST_CHECK(!LoadValidationCache(restored, path));
+    BOOST_CHECK(restored.m_signature_cache.GetNonce() == nonce);
+
+    // A missing file is not an error worth more than a log line
+    BOOST_CHECK(!LoadValidationCache(restored, m_args.GetDataDirBase() / "missing.dat"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
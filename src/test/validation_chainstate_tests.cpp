@@ -19,6 +19,7 @@
 #include <util/check.h>
 #include <validation.h>
 
+#include <memory>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -90,6 +91,29 @@ BOOST_FIXTURE_TEST_CASE(connect_tip_does_not_cache_inputs_on_failed_connect, Tes
     BOOST_CHECK(!chainstate.CoinsTip().HaveCoinInCache(outpoint));    // input not cached
 }
 
+BOOST_FIXTURE_TEST_CASE(flush_discards_inputs_fetched_ahead, TestChain100Setup)
+{
+    ChainstateManager& chainman{*Assert(m_node.chainman)};
+    Chainstate& chainstate{chainman.ActiveChainstate()};
+    auto& fetcher{chainman.GetInputFetcher()};
+    BOOST_REQUIRE(fetcher.HasThreads());
+
+    LOCK(cs_main);
+    CBlock tip_block;
+    BOOST_REQUIRE(chainman.m_blockman.ReadBlock(tip_block, *chainstate.m_chain.Tip()));
+    const auto next{std::make_shared<const CBlock>(CreateBlock({}, CScript{} << OP_TRUE, chainstate))};
+
+    fetcher.FetchNextInputs(chainstate.CoinsTip(), chainstate.CoinsDB(), tip_block, next);
+    fetcher.WaitForNextInputs();
+    BOOST_CHECK(fetcher.UseNextInputs(chainstate.CoinsTip(), next->GetHash()).first);
+
+    // A flush between the fetch and its use discards the fetched inputs
+    fetcher.FetchNextInputs(chainstate.CoinsTip(), chainstate.CoinsDB(), tip_block, next);
+    fetcher.WaitForNextInputs();
+    chainstate.ForceFlushStateToDisk();
+    BOOST_CHECK(!fetcher.UseNextInputs(chainstate.CoinsTip(), next->GetHash()).first);
+}
+
 //! Test UpdateTip behavior for both active and background chainstates.
 //!
 //! When run on the background chainstate, UpdateTip should do a subset
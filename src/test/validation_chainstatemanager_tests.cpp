@@ -14,17 +14,21 @@
 #include <test/util/chainstate.h>
 #include <test/util/common.h>
 #include <test/util/logging.h>
+#include <test/util/mining.h>
 #include <test/util/random.h>
 #include <test/util/setup_common.h>
 #include <test/util/validation.h>
 #include <uint256.h>
 #include <util/result.h>
+#include <util/threadpool.h>
 #include <util/vector.h>
 #include <validation.h>
 #include <validationinterface.h>
 
 #include <tinyformat.h>
 
+#include <ranges>
+#include <span>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -456,6 +460,16 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_activate_snapshot, SnapshotTestSetup)
     this->SetupSnapshot();
 }
 
+//! Test activation of a snapshot in the chunked format.
+BOOST_FIXTURE_TEST_CASE(chainstatemanager_activate_chunked_snapshot, SnapshotTestSetup)
+{
+    ChainstateManager& chainman = *Assert(m_node.chainman);
+    mineBlocks(10);
+    BOOST_REQUIRE(CreateAndActivateUTXOSnapshot(
+        this, NoMalleation, /*reset_chainstate=*/false, /*in_memory_chainstate=*/false, SnapshotMetadata::CHUNKED_VERSION));
+    BOOST_CHECK(WITH_LOCK(::cs_main, return chainman.ActiveChainstate().m_from_snapshot_blockhash.has_value()));
+}
+
 //! Test LoadBlockIndex behavior when multiple chainstates are in use.
 //!
 //! - First, verify that setBlockIndexCandidates is as expected when using a single,
@@ -909,6 +923,54 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_args, BasicTestingSetup)
 
     BOOST_CHECK(!get_opts({"-minimumchainwork=xyz"}));                                                               // invalid hex characters
     BOOST_CHECK(!get_opts({"-minimumchainwork=01234567890123456789012345678901234567890123456789012345678901234"})); // > 64 hex chars
+
+    // test -inputfetchthreads
+    BOOST_CHECK_EQUAL(get_valid_opts({}).input_fetch_threads_num, DEFAULT_INPUT_FETCH_THREADS);
+    BOOST_CHECK_EQUAL(get_valid_opts({"-inputfetchthreads=3"}).input_fetch_threads_num, 3);
+    BOOST_CHECK_EQUAL(get_valid_opts({"-inputfetchthreads=-1"}).input_fetch_threads_num, 0);
+    BOOST_CHECK_EQUAL(get_valid_opts({"-inputfetchthreads=4294967297"}).input_fetch_threads_num, MAX_INPUT_FETCH_THREADS); // would wrap to 1 as an int
+}
+
+BOOST_FIXTURE_TEST_CASE(chainstatemanager_load_external_block_file, RegTestingSetup)
+{
+    ChainstateManager& chainman{*Assert(m_node.chainman)};
+    const CChainParams& params{chainman.GetParams()};
+    const auto blocks{CreateBlockChain(20, params)};
+
+    // A block file as written during IBD, with the blocks in reverse order, and
+    // garbage and a block that fails to deserialize in between.
+    const FlatFilePos file_pos{1, 0};
+    {
+        AutoFile file{chainman.m_blockman.OpenBlockFile(file_pos, /*fReadOnly=*/false)};
+        BOOST_REQUIRE(!file.IsNull());
+        file << uint8_t{0xfe} << uint8_t{0xfa};
+        CBlockHeader bad_header{*blocks.front()};
+        ++bad_header.nNonce;
+        DataStream bad_block;
+        bad_block << bad_header << uint8_t{5};
+        file << params.MessageStart() << uint32_t(bad_block.size()) << std::span{bad_block};
+        for (const auto& block : blocks | std::views::reverse) {
+            file << params.MessageStart() << uint32_t(GetSerializeSize(TX_WITH_WITNESS(*block))) << TX_WITH_WITNESS(*block);
+            file << uint8_t{0};
+        }
+        BOOST_REQUIRE_EQUAL(file.fclose(), 0);
+    }
+
+    // All blocks but the first are out of order, and are read back once their parent was accepted.
+    std::multimap<uint256, FlatFilePos> blocks_with_unknown_parent;
+    FlatFilePos pos{file_pos};
+    ThreadPool pool{"loadblk"};
+    pool.Start(2);
+    {
+        AutoFile file{chainman.m_blockman.OpenBlockFile(file_pos, /*fReadOnly=*/true)};
+        ASSERT_DEBUG_LOG("unexpected data at file offset");
+        chainman.LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent, &pool);
+    }
+    BOOST_CHECK(blocks_with_unknown_parent.empty());
+    BOOST_REQUIRE(chainman.ActivateBestChains());
+    LOCK(cs_main);
+    BOOST_CHECK_EQUAL(chainman.ActiveHeight(), int(blocks.size()));
+    BOOST_CHECK_EQUAL(chainman.ActiveTip()->GetBlockHash(), blocks.back()->GetHash());
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -28,6 +28,8 @@ struct CoinsViewOptions {
     size_t batch_write_bytes{DEFAULT_DB_CACHE_BATCH};
     //! If non-zero, randomly exit when the database is flushed with (1/ratio) probability.
     int simulate_crash_ratio{0};
+    //! Write flushes of the coins cache to the database on a background thread.
+    bool async_flush{DEFAULT_COINS_ASYNC_FLUSH};
 };
 
 /** CCoinsView backed by the coin database (chainstate/) */
@@ -46,11 +48,15 @@ public:
     std::vector<uint256> GetHeadBlocks() const override;
     void BatchWrite(CoinsViewCacheCursor& cursor, const uint256& hashBlock) override;
     std::unique_ptr<CCoinsViewCursor> Cursor() const override;
+    //! Cursor starting at the first coin of `start`, or of the next txid after it.
+    std::unique_ptr<CCoinsViewCursor> Cursor(const Txid& start) const;
 
     //! Whether an unsupported database format is used.
     bool NeedsUpgrade();
     size_t EstimateSize() const override;
 
+    const CoinsViewOptions& GetOptions() const { return m_options; }
+
     //! Dynamically alter the underlying leveldb cache size.
     void ResizeCache(size_t new_cache_size) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 };
@@ -150,6 +150,13 @@ bool TruncateFile(FILE* file, unsigned int length)
 #endif
 }
 
+void DropFileCache(FILE* file)
+{
+#if defined(POSIX_FADV_DONTNEED)
+    posix_fadvise(fileno(file), 0, 0, POSIX_FADV_DONTNEED);
+#endif
+}
+
 /**
  * this function tries to raise the file descriptor limit to the requested number.
  * It returns the actual file descriptor limit (which may be more or less than nMinFD)
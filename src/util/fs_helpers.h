@@ -44,6 +44,13 @@ bool FileCommit(FILE* file);
 void DirectoryCommit(const fs::path& dirname);
 
 bool TruncateFile(FILE* file, unsigned int length);
+
+/**
+ * Advise the OS that the cached contents of a file will not be needed soon,
+ * so they can be evicted from the page cache. Only pages that have been
+ * written to disk are evicted. A no-op where this is not supported.
+ */
+void DropFileCache(FILE* file);
 int RaiseFileDescriptorLimit(int nMinFD);
 void AllocateFileRange(FILE* file, unsigned int offset, unsigned int length);
 
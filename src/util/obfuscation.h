@@ -16,6 +16,10 @@
 #include <ios>
 #include <memory>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 class Obfuscation
 {
 public:
@@ -44,11 +48,9 @@ public:
                 target = {std::assume_aligned<KEY_SIZE>(target.data() + alignment), target.size() - alignment};
                 rot_key = m_rotations[(key_offset + alignment) % KEY_SIZE];
             }
-            // Aligned obfuscation in 8*KEY_SIZE chunks
-            for (constexpr auto unroll{8}; target.size() >= KEY_SIZE * unroll; target = target.subspan(KEY_SIZE * unroll)) {
-                for (size_t i{0}; i < unroll; ++i) {
-                    XorWord(target.subspan(i * KEY_SIZE, KEY_SIZE), rot_key);
-                }
+            // Aligned obfuscation in CHUNK_SIZE chunks
+            for (; target.size() >= CHUNK_SIZE; target = target.subspan(CHUNK_SIZE)) {
+                XorChunk(target.first<CHUNK_SIZE>(), rot_key);
             }
             // Aligned obfuscation in KEY_SIZE chunks
             for (; target.size() >= KEY_SIZE; target = target.subspan(KEY_SIZE)) {
@@ -101,6 +103,27 @@ private:
         return key;
     }
 
+    //! Number of bytes obfuscated at once in the main loop, a cache line on most platforms.
+    static constexpr size_t CHUNK_SIZE{8 * KEY_SIZE};
+
+    static void XorChunk(std::span<std::byte, CHUNK_SIZE> target, KeyType key)
+    {
+#if defined(__SSE2__)
+        // Key rotations repeat every KEY_SIZE bytes, so a 16 byte lane holds the key twice.
+        const __m128i key128{_mm_set1_epi64x(static_cast<long long>(key))};
+        auto* const lanes{reinterpret_cast<__m128i*>(target.data())};
+        static_assert(CHUNK_SIZE == 4 * sizeof(__m128i));
+        _mm_storeu_si128(lanes + 0, _mm_xor_si128(_mm_loadu_si128(lanes + 0), key128));
+        _mm_storeu_si128(lanes + 1, _mm_xor_si128(_mm_loadu_si128(lanes + 1), key128));
+        _mm_storeu_si128(lanes + 2, _mm_xor_si128(_mm_loadu_si128(lanes + 2), key128));
+        _mm_storeu_si128(lanes + 3, _mm_xor_si128(_mm_loadu_si128(lanes + 3), key128));
+#else
+        for (size_t i{0}; i < CHUNK_SIZE / KEY_SIZE; ++i) {
+            XorWord(target.subspan(i * KEY_SIZE, KEY_SIZE), key);
+        }
+#endif
+    }
+
     static void XorWord(std::span<std::byte> target, KeyType key)
     {
         assert(target.size() <= KEY_SIZE);
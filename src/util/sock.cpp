@@ -13,14 +13,25 @@
 #include <util/threadinterrupt.h>
 #include <util/time.h>
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
+
+#ifndef WIN32
+#include <sys/uio.h>
+#endif
 
 #ifdef USE_POLL
 #include <poll.h>
 #endif
 
+#ifdef USE_EPOLL
+#include <sys/epoll.h>
+#endif
+
 static inline bool IOErrorIsPermanent(int err)
 {
     return err != WSAEAGAIN && err != WSAEINTR && err != WSAEWOULDBLOCK && err != WSAEINPROGRESS;
@@ -49,6 +60,30 @@ ssize_t Sock::Send(const void* data, size_t len, int flags) const
     return send(m_socket, static_cast<const char*>(data), len, flags);
 }
 
+ssize_t Sock::SendV(std::span<const std::span<const unsigned char>> bufs, int flags) const
+{
+#ifdef WIN32
+    std::array<WSABUF, MAX_SEND_BUFFERS> wsabufs;
+    DWORD count{0};
+    for (const auto& buf : bufs.first(std::min(bufs.size(), wsabufs.size()))) {
+        wsabufs[count++] = WSABUF{static_cast<ULONG>(buf.size()), reinterpret_cast<CHAR*>(const_cast<unsigned char*>(buf.data()))};
+    }
+    DWORD sent{0};
+    if (WSASend(m_socket, wsabufs.data(), count, &sent, static_cast<DWORD>(flags), nullptr, nullptr) == SOCKET_ERROR) {
+        return SOCKET_ERROR;
+    }
+    return static_cast<ssize_t>(sent);
+#else
+    std::array<iovec, MAX_SEND_BUFFERS> iov;
+    msghdr msg{};
+    msg.msg_iov = iov.data();
+    for (const auto& buf : bufs.first(std::min(bufs.size(), iov.size()))) {
+        iov[msg.msg_iovlen++] = iovec{const_cast<unsigned char*>(buf.data()), buf.size()};
+    }
+    return sendmsg(m_socket, &msg, flags);
+#endif
+}
+
 ssize_t Sock::Recv(void* buf, size_t len, int flags) const
 {
     return recv(m_socket, static_cast<char*>(buf), len, flags);
@@ -246,6 +281,106 @@ bool Sock::WaitMany(std::chrono::milliseconds timeout, EventsPerSock& events_per
 #endif /* USE_POLL */
 }
 
+Sock::EventPoller::EventPoller()
+{
+#ifdef USE_EPOLL
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll_fd == -1) {
+        LogWarning("Failed to create epoll instance: %s", NetworkErrorString(errno));
+    }
+#endif
+}
+
+Sock::EventPoller::~EventPoller()
+{
+#ifdef USE_EPOLL
+    if (m_epoll_fd != -1) close(m_epoll_fd);
+#endif
+}
+
+bool Sock::EventPoller::IsAvailable() const
+{
+#ifdef USE_EPOLL
+    return m_epoll_fd != -1;
+#else
+    return false;
+#endif
+}
+
+bool Sock::EventPoller::WaitMany(std::chrono::milliseconds timeout, EventsPerSock& events_per_sock)
+{
+#ifdef USE_EPOLL
+    if (m_epoll_fd == -1) return false;
+
+    // Bring the registrations up to date with the requested events.
+    for (auto& [fd, registration] : m_registrations) registration.current = nullptr;
+    for (auto& [sock, events] : events_per_sock) {
+        events.occurred = 0;
+        const SOCKET fd{sock->m_socket};
+        epoll_event ev{};
+        if (events.requested & RECV) ev.events |= EPOLLIN;
+        if (events.requested & SEND) ev.events |= EPOLLOUT;
+        ev.data.fd = fd;
+
+        const auto ctl{[&](int op) { return epoll_ctl(m_epoll_fd, op, fd, &ev) == 0; }};
+        const auto [it, inserted]{m_registrations.try_emplace(fd)};
+        Registration& registration{it->second};
+        bool ok{true};
+        if (inserted) {
+            ok = ctl(EPOLL_CTL_ADD) || (errno == EEXIST && ctl(EPOLL_CTL_MOD));
+        } else if (registration.events != ev.events || registration.sock != sock) {
+            ok = ctl(EPOLL_CTL_MOD) || (errno == ENOENT && ctl(EPOLL_CTL_ADD));
+        }
+        if (!ok) {
+            // Report the failure on the socket, like poll(2) would for an invalid descriptor.
+            events.occurred = ERR;
+            m_registrations.erase(it);
+            continue;
+        }
+        registration.sock = sock;
+        registration.events = ev.events;
+        registration.current = &events;
+    }
+
+    // Release the sockets that are no longer waited for.
+    for (auto it{m_registrations.begin()}; it != m_registrations.end();) {
+        if (it->second.current) {
+            ++it;
+            continue;
+        }
+        epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, it->first, nullptr);
+        it = m_registrations.erase(it);
+    }
+    if (m_registrations.empty()) return false;
+
+    std::vector<epoll_event> ready(m_registrations.size());
+    const int num_ready{epoll_wait(m_epoll_fd, ready.data(), ready.size(), count_milliseconds(timeout))};
+    if (num_ready == SOCKET_ERROR) {
+        // Being interrupted by a signal is reported like a timeout.
+        return errno == EINTR;
+    }
+
+    for (const epoll_event& ev : std::span{ready}.first(num_ready)) {
+        const auto it{m_registrations.find(ev.data.fd)};
+        if (it == m_registrations.end()) continue;
+        Events& events{*it->second.current};
+        if (ev.events & EPOLLIN) {
+            events.occurred |= RECV;
+        }
+        if (ev.events & EPOLLOUT) {
+            events.occurred |= SEND;
+        }
+        if (ev.events & (EPOLLERR | EPOLLHUP)) {
+            events.occurred |= ERR;
+        }
+    }
+
+    return true;
+#else
+    return false;
+#endif /* USE_EPOLL */
+}
+
 void Sock::SendComplete(std::span<const unsigned char> data,
                         std::chrono::milliseconds timeout,
                         CThreadInterrupt& interrupt) const
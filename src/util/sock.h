@@ -65,6 +65,17 @@ public:
      */
     [[nodiscard]] virtual ssize_t Send(const void* data, size_t len, int flags) const;
 
+    /**
+     * sendmsg(2) wrapper (WSASend() on Windows), sending the buffers in order with a single call.
+     * Returns like `Send()`, and may send only a part of the buffers. Sends at most
+     * `MAX_SEND_BUFFERS` buffers. Code that uses this wrapper can be unit tested if this method is
+     * overridden by a mock Sock implementation.
+     */
+    [[nodiscard]] virtual ssize_t SendV(std::span<const std::span<const unsigned char>> bufs, int flags) const;
+
+    /** Maximum number of buffers sent by one `SendV()` call. */
+    static constexpr size_t MAX_SEND_BUFFERS{16};
+
     /**
      * recv(2) wrapper. Equivalent to `recv(m_socket, buf, len, flags);`. Code that uses this
      * wrapper can be unit tested if this method is overridden by a mock Sock implementation.
@@ -219,6 +230,8 @@ public:
     [[nodiscard]] virtual bool WaitMany(std::chrono::milliseconds timeout,
                                         EventsPerSock& events_per_sock) const;
 
+    class EventPoller;
+
     /* Higher level, convenience, methods. These may throw. */
 
     /**
@@ -282,6 +295,49 @@ private:
     void Close();
 };
 
+/**
+ * Persistent readiness backend for waiting on many sockets, based on epoll(7).
+ * Unlike `Sock::WaitMany()`, which hands all sockets to the kernel on every
+ * call, sockets stay registered between calls, and each call only adds,
+ * modifies or removes the registrations that changed since the previous one.
+ *
+ * A socket stays registered, and is kept open, until a call to `WaitMany()`
+ * no longer includes it. This prevents its file descriptor from being reused
+ * by a new socket while it is registered.
+ *
+ * Only available where `USE_EPOLL` is defined, see `IsAvailable()`. Not thread safe.
+ */
+class Sock::EventPoller
+{
+public:
+    EventPoller();
+    ~EventPoller();
+
+    EventPoller(const EventPoller&) = delete;
+    EventPoller& operator=(const EventPoller&) = delete;
+
+    /** Whether this platform supports the backend and it could be initialized. */
+    bool IsAvailable() const;
+
+    /**
+     * Same as `Sock::WaitMany()`, using the persistent registrations.
+     * @return false if the wait failed or there are no sockets to wait for
+     */
+    [[nodiscard]] bool WaitMany(std::chrono::milliseconds timeout, EventsPerSock& events_per_sock);
+
+private:
+#ifdef USE_EPOLL
+    struct Registration {
+        std::shared_ptr<const Sock> sock;
+        uint32_t events{0};
+        Events* current{nullptr};
+    };
+
+    int m_epoll_fd{-1};
+    std::unordered_map<SOCKET, Registration> m_registrations;
+#endif
+};
+
 /** Return readable error string for a network error code */
 std::string NetworkErrorString(int err);
 
@@ -48,6 +48,7 @@
 #include <txmempool.h>
 #include <uint256.h>
 #include <undo.h>
+#include <util/byte_units.h>
 #include <util/check.h>
 #include <util/fs.h>
 #include <util/fs_helpers.h>
@@ -59,6 +60,7 @@
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
 #include <util/string.h>
+#include <util/threadpool.h>
 #include <util/time.h>
 #include <util/trace.h>
 #include <util/translation.h>
@@ -68,6 +70,8 @@
 #include <cassert>
 #include <chrono>
 #include <deque>
+#include <exception>
+#include <future>
 #include <numeric>
 #include <optional>
 #include <ranges>
@@ -87,6 +91,7 @@ using node::BlockManager;
 using node::BlockMap;
 using node::CBlockIndexHeightOnlyComparator;
 using node::CBlockIndexWorkComparator;
+using node::SnapshotCoinsReader;
 using node::SnapshotMetadata;
 
 /** Time window to wait between writing blocks/block index and chainstate to disk.
@@ -111,6 +116,8 @@ const std::vector<std::string> CHECKLEVEL_DOC {
  *  noticeably interfere with the pruning mechanism.
  * */
 static constexpr int PRUNE_LOCK_BUFFER{10};
+/** Serialized size of the blocks read ahead by LoadExternalBlockFile(), before they are accepted. */
+static constexpr size_t MAX_IMPORT_QUEUED_BYTES{32_MiB};
 
 TRACEPOINT_SEMAPHORE(validation, block_connected);
 TRACEPOINT_SEMAPHORE(utxocache, flush);
@@ -1848,12 +1855,13 @@ CAmount GetBlockSubsidy(int nHeight, const Consensus::Params& consensusParams)
 
 CoinsViews::CoinsViews(DBParams db_params, CoinsViewOptions options)
     : m_dbview{std::move(db_params), std::move(options)},
-      m_catcherview(&m_dbview) {}
+      m_catcherview(&m_dbview),
+      m_asyncview{&m_catcherview, m_dbview.GetOptions().async_flush} {}
 
 void CoinsViews::InitCache()
 {
     AssertLockHeld(::cs_main);
-    m_cacheview = std::make_unique<CCoinsViewCache>(&m_catcherview);
+    m_cacheview = std::make_unique<CCoinsViewCache>(&m_asyncview);
     m_connect_block_view = std::make_unique<CoinsViewOverlay>(&*m_cacheview);
 }
 
@@ -2024,16 +2032,22 @@ ValidationCache::ValidationCache(const size_t script_execution_cache_bytes, cons
     : m_signature_cache{signature_cache_bytes}
 {
     // Setup the salted hasher
-    uint256 nonce = GetRandHash();
+    SetScriptExecutionCacheNonce(GetRandHash());
+
+    const auto [num_elems, approx_size_bytes] = m_script_execution_cache.setup_bytes(script_execution_cache_bytes);
+    LogInfo("Using %zu MiB out of %zu MiB requested for script execution cache, able to store %zu elements",
+              approx_size_bytes >> 20, script_execution_cache_bytes >> 20, num_elems);
+}
+
+void ValidationCache::SetScriptExecutionCacheNonce(const uint256& nonce)
+{
+    m_script_execution_cache_nonce = nonce;
+    m_script_execution_cache_hasher.Reset();
     // We want the nonce to be 64 bytes long to force the hasher to process
     // this chunk, which makes later hash computations more efficient. We
     // just write our 32-byte entropy twice to fill the 64 bytes.
     m_script_execution_cache_hasher.Write(nonce.begin(), 32);
     m_script_execution_cache_hasher.Write(nonce.begin(), 32);
-
-    const auto [num_elems, approx_size_bytes] = m_script_execution_cache.setup_bytes(script_execution_cache_bytes);
-    LogInfo("Using %zu MiB out of %zu MiB requested for script execution cache, able to store %zu elements",
-              approx_size_bytes >> 20, script_execution_cache_bytes >> 20, num_elems);
 }
 
 /**
@@ -2683,7 +2697,8 @@ CoinsCacheSizeState Chainstate::GetCoinsCacheSizeState(
 {
     AssertLockHeld(::cs_main);
     const int64_t nMempoolUsage = m_mempool ? m_mempool->DynamicMemoryUsage() : 0;
-    int64_t cacheSize = CoinsTip().DynamicMemoryUsage();
+    // With -asyncflush, the coins of a flush that is still being written are held in memory too.
+    int64_t cacheSize = CoinsTip().DynamicMemoryUsage() + m_coins_views->m_asyncview.DynamicMemoryUsage();
     int64_t nTotalSpace =
         max_coins_cache_size_bytes + std::max<int64_t>(int64_t(max_mempool_size_bytes) - nMempoolUsage, 0);
 
@@ -2714,6 +2729,14 @@ bool Chainstate::FlushStateToDisk(
         bool fFlushForPrune = false;
 
         CoinsCacheSizeState cache_state = GetCoinsCacheSizeState();
+        if (cache_state >= CoinsCacheSizeState::CRITICAL && m_coins_views->m_asyncview.IsFlushing()) {
+            // Over the limit while the previous flush is still being written, which holds its
+            // coins in memory. Flushing again would wait for that write anyway, so wait for it
+            // to release them first, and only flush if the cache alone is still too large.
+            LOG_TIME_MILLIS_WITH_CATEGORY("wait for background write of the coins cache", BCLog::BENCH);
+            m_coins_views->m_asyncview.WaitForFlush();
+            cache_state = GetCoinsCacheSizeState();
+        }
         LOCK(m_blockman.cs_LastBlockFile);
         if (m_blockman.IsPruneMode() && (m_blockman.m_check_for_pruning || nManualPruneHeight > 0) && m_chainman.m_blockman.m_blockfiles_indexed) {
             // make sure we don't prune above any of the prune locks bestblocks
@@ -2771,6 +2794,10 @@ bool Chainstate::FlushStateToDisk(
             LogDebug(BCLog::COINDB, "Writing chainstate to disk: flush mode=%s, prune=%d, large=%d, critical=%d, periodic=%d",
                      FlushStateModeNames[size_t(mode)], fFlushForPrune, fCacheLarge, fCacheCritical, fPeriodicWrite);
 
+            // The next block's inputs were looked up while spent coins were still in the
+            // cache, which the write below removes. They can't be used safely afterwards.
+            m_chainman.GetInputFetcher().DiscardNextInputs();
+
             // Ensure we can write block index
             if (!CheckDiskSpace(m_blockman.m_opts.blocks_dir)) {
                 return FatalError(m_chainman.GetNotifications(), state, _("Disk space is too low!"));
@@ -2784,6 +2811,13 @@ bool Chainstate::FlushStateToDisk(
                 if (!m_blockman.FlushChainstateBlockFile(m_chain.Height())) {
                     LogWarning("%s: Failed to flush block file.\n", __func__);
                 }
+                // With -asyncblockwrites the data may still be queued, and the
+                // block index must not refer to data that is not on disk yet.
+                // The failure itself was already reported by the writer.
+                if (!m_blockman.WaitForBlockWrites()) {
+                    return state.Error("Failed to write block and undo data to disk");
+                }
+                m_blockman.DropBlockFileCaches(m_chain.Height());
             }
 
             // Then update all block file information (which may refer to block and undo files).
@@ -2796,7 +2830,9 @@ bool Chainstate::FlushStateToDisk(
             if (fFlushForPrune) {
                 LOG_TIME_MILLIS_WITH_CATEGORY("unlink pruned files", BCLog::BENCH);
 
-                m_blockman.UnlinkPrunedFiles(setFilesToPrune);
+                // Blocks needed to replay a pending background write must not be deleted.
+                m_coins_views->m_asyncview.WaitForFlush();
+                m_blockman.ScheduleUnlinkPrunedFiles(std::move(setFilesToPrune));
             }
 
             if (!CoinsTip().GetBestBlock().IsNull()) {
@@ -2810,6 +2846,11 @@ bool Chainstate::FlushStateToDisk(
                 }
                 // Flush the chainstate (which may refer to block index entries).
                 empty_cache ? CoinsTip().Flush() : CoinsTip().Sync();
+                // With -asyncflush the coins are now being written in the background. Forced
+                // flushes (e.g. at shutdown) and pruning need them on disk before returning.
+                if (mode == FlushStateMode::FORCE_FLUSH || mode == FlushStateMode::FORCE_SYNC || fFlushForPrune) {
+                    m_coins_views->m_asyncview.WaitForFlush();
+                }
                 full_flush_completed = true;
                 TRACEPOINT(utxocache, flush,
                     int64_t{Ticks<std::chrono::microseconds>(NodeClock::now() - nNow)},
@@ -2937,6 +2978,8 @@ bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTra
         LogError("DisconnectTip(): Failed to read block\n");
         return false;
     }
+    // Inputs fetched ahead of time were looked up against the chain state being rolled back.
+    m_chainman.GetInputFetcher().DiscardNextInputs();
     // Apply the block atomically to the chain state.
     const auto time_start{SteadyClock::now()};
     {
@@ -3031,12 +3074,16 @@ public:
  * Connect a new block to m_chain. block_to_connect is either nullptr or a pointer to a CBlock
  * corresponding to pindexNew, to bypass loading it again from disk.
  *
+ * pindex_next is either nullptr or the block expected to be connected right after pindexNew.
+ * Its inputs are then fetched in the background while pindexNew is connected.
+ *
  * The block is added to connectTrace if connection succeeds.
  */
 bool Chainstate::ConnectTip(
     BlockValidationState& state,
     CBlockIndex* pindexNew,
     std::shared_ptr<const CBlock> block_to_connect,
+    const CBlockIndex* pindex_next,
     ConnectTrace& connectTrace,
     DisconnectedBlockTransactions& disconnectpool)
 {
@@ -3044,9 +3091,15 @@ bool Chainstate::ConnectTip(
     if (m_mempool) AssertLockHeld(m_mempool->cs);
 
     assert(pindexNew->pprev == m_chain.Tip());
+    auto& fetcher{m_chainman.GetInputFetcher()};
+    // Pick up the inputs fetched while the previous block was connected.
+    auto [next_block, fetched_ahead]{fetcher.UseNextInputs(CoinsTip(), pindexNew->GetBlockHash())};
     // Read block from disk.
     const auto time_1{SteadyClock::now()};
-    if (!block_to_connect) {
+    if (!block_to_connect && next_block) {
+        LogDebug(BCLog::BENCH, "  - Using block read ahead\n");
+        block_to_connect = std::move(next_block);
+    } else if (!block_to_connect) {
         std::shared_ptr<CBlock> pblockNew = std::make_shared<CBlock>();
         if (!m_blockman.ReadBlock(*pblockNew, *pindexNew)) {
             return FatalError(m_chainman.GetNotifications(), state, _("Failed to read block."));
@@ -3062,6 +3115,20 @@ bool Chainstate::ConnectTip(
     // num_blocks_total may be zero until the ConnectBlock() call below.
     LogDebug(BCLog::BENCH, "  - Load block from disk: %.2fms\n",
              Ticks<MillisecondsDouble>(time_2 - time_1));
+    if (fetcher.HasThreads()) {
+        // The block has passed CheckBlock in AcceptBlock, so warm the coins cache with its
+        // inputs in parallel before ConnectBlock looks them up one at a time.
+        const size_t fetched{fetcher.FetchInputs(CoinsTip(), m_coins_views->m_asyncview, *block_to_connect)};
+        LogDebug(BCLog::BENCH, "  - Prefetch %u inputs (%u fetched ahead): %.2fms\n", fetched + fetched_ahead, fetched_ahead,
+                 Ticks<MillisecondsDouble>(SteadyClock::now() - time_2));
+        // Overlap the database reads for the next block with the script checks of this one.
+        if (pindex_next) {
+            auto block_next{std::make_shared<CBlock>()};
+            if (m_blockman.ReadBlock(*block_next, *pindex_next)) {
+                fetcher.FetchNextInputs(CoinsTip(), m_coins_views->m_asyncview, *block_to_connect, std::move(block_next));
+            }
+        }
+    }
     {
         CCoinsViewCache& view{*m_coins_views->m_connect_block_view};
         const auto reset_guard{view.CreateResetGuard()};
@@ -3070,6 +3137,8 @@ bool Chainstate::ConnectTip(
             m_chainman.m_options.signals->BlockChecked(block_to_connect, state);
         }
         if (!rv) {
+            fetcher.DiscardNextInputs();
+            fetcher.UncacheInputs(CoinsTip());
             if (state.IsInvalid())
                 InvalidBlockFound(pindexNew, state);
             LogError("%s: ConnectBlock %s failed, %s\n", __func__, pindexNew->GetBlockHash().ToString(), state.ToString());
@@ -3090,6 +3159,8 @@ bool Chainstate::ConnectTip(
              Ticks<MillisecondsDouble>(time_4 - time_3),
              Ticks<SecondsDouble>(m_chainman.time_flush),
              Ticks<MillisecondsDouble>(m_chainman.time_flush) / m_chainman.num_blocks_total);
+    // The database must not be written to while the next block's inputs are being read from it.
+    fetcher.WaitForNextInputs();
     // Write the chain state to disk, if necessary.
     if (!FlushStateToDisk(state, FlushStateMode::IF_NEEDED)) {
         return false;
@@ -3264,7 +3335,8 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex*
 
         // Connect new blocks.
         for (CBlockIndex* pindexConnect : vpindexToConnect | std::views::reverse) {
-            if (!ConnectTip(state, pindexConnect, pindexConnect == pindexMostWork ? pblock : std::shared_ptr<const CBlock>(), connectTrace, disconnectpool)) {
+            const CBlockIndex* pindex_next{pindexMostWork->GetAncestor(pindexConnect->nHeight + 1)};
+            if (!ConnectTip(state, pindexConnect, pindexConnect == pindexMostWork ? pblock : std::shared_ptr<const CBlock>(), pindex_next, connectTrace, disconnectpool)) {
                 if (state.IsInvalid()) {
                     // The block violates a consensus rule.
                     if (state.GetResult() != BlockValidationResult::BLOCK_MUTATED) {
@@ -4934,7 +5006,7 @@ bool ChainstateManager::LoadBlockIndex()
     AssertLockHeld(cs_main);
     // Load block index from databases
     if (m_blockman.m_blockfiles_indexed) {
-        bool ret{m_blockman.LoadBlockIndexDB(CurrentChainstate().m_from_snapshot_blockhash)};
+        bool ret{m_blockman.LoadBlockIndexDB(CurrentChainstate().m_from_snapshot_blockhash, m_options.worker_threads_num)};
         if (!ret) return false;
 
         m_blockman.ScanAndUnlinkAlreadyPrunedFiles();
@@ -4985,10 +5057,52 @@ bool Chainstate::LoadGenesisBlock()
     return true;
 }
 
+namespace {
+//! Serialized size of a block header.
+constexpr size_t HEADER_SIZE{80};
+
+//! A block found in an external block file.
+struct ExternalBlock {
+    //! Position of the serialized block in the file.
+    uint64_t pos;
+    CBlockHeader header;
+    uint256 hash;
+    //! The serialized block, until it is deserialized.
+    std::vector<std::byte> data;
+    //! Set once the block is deserialized, unless that failed.
+    std::shared_ptr<CBlock> block;
+    std::exception_ptr error;
+};
+
+ExternalBlock ReadExternalBlockHeader(uint64_t pos, std::vector<std::byte> data)
+{
+    ExternalBlock result;
+    result.pos = pos;
+    // The data is at least HEADER_SIZE bytes, see LoadExternalBlockFile().
+    SpanReader{data} >> result.header;
+    result.hash = result.header.GetHash();
+    result.data = std::move(data);
+    return result;
+}
+
+void DeserializeExternalBlock(ExternalBlock& entry)
+{
+    try {
+        auto block{std::make_shared<CBlock>()};
+        SpanReader{entry.data} >> TX_WITH_WITNESS(*block);
+        entry.block = std::move(block);
+    } catch (const std::exception&) {
+        entry.error = std::current_exception();
+    }
+    entry.data = {};
+}
+} // namespace
+
 void ChainstateManager::LoadExternalBlockFile(
     AutoFile& file_in,
     FlatFilePos* dbp,
-    std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent)
+    std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent,
+    ThreadPool* pool)
 {
     // Either both should be specified (-reindex), or neither (-loadblock).
     assert(!dbp == !blocks_with_unknown_parent);
@@ -4996,50 +5110,94 @@ void ChainstateManager::LoadExternalBlockFile(
     const auto start{SteadyClock::now()};
     const CChainParams& params{GetParams()};
 
+    // Blocks are located in the file on this thread, then deserialized and
+    // hashed on the pool's worker threads, and accepted on this thread in file
+    // order. Without worker threads, only blocks that are accepted are deserialized.
+    const size_t num_workers{pool ? pool->WorkersCount() : 0};
+    std::deque<std::pair<std::future<ExternalBlock>, size_t>> pending;
+    size_t pending_bytes{0};
+
     int nLoaded = 0;
     try {
         BufferedFile blkdat{file_in, 2 * MAX_BLOCK_SERIALIZED_SIZE, MAX_BLOCK_SERIALIZED_SIZE + 8};
         // nRewind indicates where to resume scanning in case something goes wrong,
-        // such as a block fails to deserialize.
+        // such as a block fails to be read.
         uint64_t nRewind = blkdat.GetPos();
-        while (!blkdat.eof()) {
+        bool scanned{false};
+        // Locate the next block and queue its deserialization. Return false at the end of the file.
+        const auto queue_next_block{[&]() -> bool {
+            while (!blkdat.eof()) {
+                blkdat.SetPos(nRewind);
+                nRewind++; // start one byte further next time, in case of failure
+                blkdat.SetLimit(); // remove former limit
+                unsigned int nSize = 0;
+                try {
+                    // locate a header
+                    MessageStartChars buf;
+                    blkdat.FindByte(std::byte(params.MessageStart()[0]));
+                    nRewind = blkdat.GetPos() + 1;
+                    blkdat >> buf;
+                    if (buf != params.MessageStart()) {
+                        continue;
+                    }
+                    // read size
+                    blkdat >> nSize;
+                    if (nSize < HEADER_SIZE || nSize > MAX_BLOCK_SERIALIZED_SIZE)
+                        continue;
+                } catch (const std::exception&) {
+                    // no valid block header found; don't complain
+                    // (this happens at the end of every blk.dat file)
+                    return false;
+                }
+                try {
+                    // read the block, starting with its header
+                    const uint64_t nBlockPos{blkdat.GetPos()};
+                    blkdat.SetLimit(nBlockPos + nSize);
+                    std::vector<std::byte> data(nSize);
+                    blkdat.read(std::span{data}.first(HEADER_SIZE));
+                    // Position to the marker before the next block.
+                    nRewind = nBlockPos + nSize;
+                    blkdat.read(std::span{data}.subspan(HEADER_SIZE));
+
+                    std::future<ExternalBlock> future;
+                    if (num_workers > 0) {
+                        future = std::move(*Assert(pool->Submit([nBlockPos, data = std::move(data)]() mutable {
+                            auto entry{ReadExternalBlockHeader(nBlockPos, std::move(data))};
+                            DeserializeExternalBlock(entry);
+                            return entry;
+                        })));
+                    } else {
+                        std::promise<ExternalBlock> result;
+                        result.set_value(ReadExternalBlockHeader(nBlockPos, std::move(data)));
+                        future = result.get_future();
+                    }
+                    pending.emplace_back(std::move(future), nSize);
+                    pending_bytes += nSize;
+                    return true;
+                } catch (const std::exception& e) {
+                    LogDebug(BCLog::REINDEX, "%s: unexpected data at file offset 0x%x - %s. continuing\n", __func__, (nRewind - 1), e.what());
+                }
+            }
+            return false;
+        }};
+
+        while (true) {
             if (m_interrupt) return;
 
-            blkdat.SetPos(nRewind);
-            nRewind++; // start one byte further next time, in case of failure
-            blkdat.SetLimit(); // remove former limit
-            unsigned int nSize = 0;
-            try {
-                // locate a header
-                MessageStartChars buf;
-                blkdat.FindByte(std::byte(params.MessageStart()[0]));
-                nRewind = blkdat.GetPos() + 1;
-                blkdat >> buf;
-                if (buf != params.MessageStart()) {
-                    continue;
-                }
-                // read size
-                blkdat >> nSize;
-                if (nSize < 80 || nSize > MAX_BLOCK_SERIALIZED_SIZE)
-                    continue;
-            } catch (const std::exception&) {
-                // no valid block header found; don't complain
-                // (this happens at the end of every blk.dat file)
-                break;
+            // Keep the workers busy, within a bound on the memory used by queued blocks.
+            while (!scanned && (pending.empty() || (pending.size() <= 2 * num_workers && pending_bytes < MAX_IMPORT_QUEUED_BYTES))) {
+                scanned = !queue_next_block();
             }
+            if (pending.empty()) break;
+            ExternalBlock entry{pending.front().first.get()};
+            pending_bytes -= pending.front().second;
+            pending.pop_front();
+
             try {
-                // read block header
-                const uint64_t nBlockPos{blkdat.GetPos()};
                 if (dbp)
-                    dbp->nPos = nBlockPos;
-                blkdat.SetLimit(nBlockPos + nSize);
-                CBlockHeader header;
-                blkdat >> header;
-                const uint256 hash{header.GetHash()};
-                // Skip the rest of this block (this may read from disk into memory); position to the marker before the
-                // next block, but it's still possible to rewind to the start of the current block (without a disk read).
-                nRewind = nBlockPos + nSize;
-                blkdat.SkipTo(nRewind);
+                    dbp->nPos = entry.pos;
+                const CBlockHeader& header{entry.header};
+                const uint256& hash{entry.hash};
 
                 std::shared_ptr<CBlock> pblock{}; // needs to remain available after the cs_main lock is released to avoid duplicate reads from disk
 
@@ -5058,11 +5216,10 @@ void ChainstateManager::LoadExternalBlockFile(
                     // process in case the block isn't known yet
                     const CBlockIndex* pindex = m_blockman.LookupBlockIndex(hash);
                     if (!pindex || (pindex->nStatus & BLOCK_HAVE_DATA) == 0) {
-                        // This block can be processed immediately; rewind to its start, read and deserialize it.
-                        blkdat.SetPos(nBlockPos);
-                        pblock = std::make_shared<CBlock>();
-                        blkdat >> TX_WITH_WITNESS(*pblock);
-                        nRewind = blkdat.GetPos();
+                        // This block can be processed immediately, if it deserializes.
+                        if (!entry.block && !entry.error) DeserializeExternalBlock(entry);
+                        if (entry.error) std::rethrow_exception(entry.error);
+                        pblock = std::move(entry.block);
 
                         BlockValidationState state;
                         if (AcceptBlock(pblock, state, nullptr, true, dbp, nullptr, true)) {
@@ -5145,7 +5302,7 @@ void ChainstateManager::LoadExternalBlockFile(
                 // the reindex process is not the place to attempt to clean and/or compact the block files. if so desired, a studious node operator
                 // may use knowledge of the fact that the block files are not entirely pristine in order to prepare a set of pristine, and
                 // perhaps ordered, block files for later reindexing.
-                LogDebug(BCLog::REINDEX, "%s: unexpected data at file offset 0x%x - %s. continuing\n", __func__, (nRewind - 1), e.what());
+                LogDebug(BCLog::REINDEX, "%s: unexpected data at file offset 0x%x - %s. continuing\n", __func__, entry.pos, e.what());
             }
         }
     } catch (const std::runtime_error& e) {
@@ -5808,78 +5965,53 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
     }
 
     const uint64_t coins_count = metadata.m_coins_count;
-    uint64_t coins_left = metadata.m_coins_count;
 
-    LogInfo("[snapshot] loading %d coins from snapshot %s", coins_left, base_blockhash.ToString());
+    LogInfo("[snapshot] loading %d coins from snapshot %s", coins_count, base_blockhash.ToString());
     int64_t coins_processed{0};
 
-    while (coins_left > 0) {
-        try {
-            Txid txid;
-            coins_file >> txid;
-            size_t coins_per_txid{0};
-            coins_per_txid = ReadCompactSize(coins_file);
+    // The coins are decoded, checked and hashed on a separate thread while
+    // they are inserted into the cache here.
+    SnapshotCoinsReader reader{coins_file, coins_count, base_height, metadata.m_version};
+    while (auto batch{reader.Next()}) {
+        for (auto& [outpoint, coin] : *batch) {
+            coins_cache.EmplaceCoinInternalDANGER(std::move(outpoint), std::move(coin));
 
-            if (coins_per_txid > coins_left) {
-                return util::Error{Untranslated("Mismatch in coins count in snapshot metadata and actual snapshot data")};
-            }
-
-            for (size_t i = 0; i < coins_per_txid; i++) {
-                COutPoint outpoint;
-                Coin coin;
-                outpoint.n = static_cast<uint32_t>(ReadCompactSize(coins_file));
-                outpoint.hash = txid;
-                coins_file >> coin;
-                if (coin.nHeight > base_height ||
-                    outpoint.n >= std::numeric_limits<decltype(outpoint.n)>::max() // Avoid integer wrap-around in coinstats.cpp:ApplyHash
-                ) {
-                    return util::Error{Untranslated(strprintf("Bad snapshot data after deserializing %d coins",
-                              coins_count - coins_left))};
-                }
-                if (!MoneyRange(coin.out.nValue)) {
-                    return util::Error{Untranslated(strprintf("Bad snapshot data after deserializing %d coins - bad tx out value",
-                              coins_count - coins_left))};
-                }
-                coins_cache.EmplaceCoinInternalDANGER(std::move(outpoint), std::move(coin));
+            ++coins_processed;
 
-                --coins_left;
-                ++coins_processed;
+            if (coins_processed % 1000000 == 0) {
+                LogInfo("[snapshot] %d coins loaded (%.2f%%, %.2f MB)",
+                    coins_processed,
+                    static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count),
+                    coins_cache.DynamicMemoryUsage() / (1000 * 1000));
+            }
 
-                if (coins_processed % 1000000 == 0) {
-                    LogInfo("[snapshot] %d coins loaded (%.2f%%, %.2f MB)",
-                        coins_processed,
-                        static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count),
-                        coins_cache.DynamicMemoryUsage() / (1000 * 1000));
+            // Batch write and flush (if we need to) every so often.
+            //
+            // If our average Coin size is roughly 41 bytes, checking every 120,000 coins
+            // means <5MB of memory imprecision.
+            if (coins_processed % 120000 == 0) {
+                if (m_interrupt) {
+                    return util::Error{Untranslated("Aborting after an interrupt was requested")};
                 }
 
-                // Batch write and flush (if we need to) every so often.
-                //
-                // If our average Coin size is roughly 41 bytes, checking every 120,000 coins
-                // means <5MB of memory imprecision.
-                if (coins_processed % 120000 == 0) {
-                    if (m_interrupt) {
-                        return util::Error{Untranslated("Aborting after an interrupt was requested")};
-                    }
+                const auto snapshot_cache_state = WITH_LOCK(::cs_main,
+                    return snapshot_chainstate.GetCoinsCacheSizeState());
 
-                    const auto snapshot_cache_state = WITH_LOCK(::cs_main,
-                        return snapshot_chainstate.GetCoinsCacheSizeState());
+                if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
+                    // This is a hack - we don't know what the actual best block is, but that
+                    // doesn't matter for the purposes of flushing the cache here. We'll set this
+                    // to its correct value (`base_blockhash`) below after the coins are loaded.
+                    coins_cache.SetBestBlock(GetRandHash());
 
-                    if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
-                        // This is a hack - we don't know what the actual best block is, but that
-                        // doesn't matter for the purposes of flushing the cache here. We'll set this
-                        // to its correct value (`base_blockhash`) below after the coins are loaded.
-                        coins_cache.SetBestBlock(GetRandHash());
-
-                        // No need to acquire cs_main since this chainstate isn't being used yet.
-                        FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
-                    }
+                    // No need to acquire cs_main since this chainstate isn't being used yet.
+                    FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
                 }
             }
-        } catch (const std::ios_base::failure&) {
-            return util::Error{Untranslated(strprintf("Bad snapshot format or truncated snapshot after deserializing %d coins",
-                      coins_processed))};
         }
     }
+    if (auto error{reader.GetError()}) {
+        return util::Error{Untranslated(std::move(*error))};
+    }
 
     // Important that we set this. This and the coins_cache accesses above are
     // sort of a layer violation, but either we reach into the innards of
@@ -5888,19 +6020,6 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
     // method.
     coins_cache.SetBestBlock(base_blockhash);
 
-    bool out_of_coins{false};
-    try {
-        std::byte left_over_byte;
-        coins_file >> left_over_byte;
-    } catch (const std::ios_base::failure&) {
-        // We expect an exception since we should be out of coins.
-        out_of_coins = true;
-    }
-    if (!out_of_coins) {
-        return util::Error{Untranslated(strprintf("Bad snapshot - coins left over after deserializing %d coins",
-            coins_count))};
-    }
-
     LogInfo("[snapshot] loaded %d (%.2f MB) coins from snapshot %s",
         coins_count,
         coins_cache.DynamicMemoryUsage() / (1000 * 1000),
@@ -5915,22 +6034,28 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
     // about the snapshot_chainstate.
     CCoinsViewDB* snapshot_coinsdb = WITH_LOCK(::cs_main, return &snapshot_chainstate.CoinsDB());
 
-    std::optional<CCoinsStats> maybe_stats;
-
-    try {
-        maybe_stats = ComputeUTXOStats(
-            CoinStatsHashType::HASH_SERIALIZED, snapshot_coinsdb, m_blockman, [&interrupt = m_interrupt] { SnapshotUTXOHashBreakpoint(interrupt); });
-    } catch (StopHashingException const&) {
-        return util::Error{Untranslated("Aborting after an interrupt was requested")};
-    }
-    if (!maybe_stats.has_value()) {
-        return util::Error{Untranslated("Failed to generate coins stats")};
+    // The hash computed while reading matches what ComputeUTXOStats() would
+    // return for the database, unless the snapshot was not in database order.
+    std::optional<uint256> hash_serialized{reader.HashSerialized()};
+    if (!hash_serialized) {
+        LogInfo("[snapshot] coins are not in database order, hashing the loaded coins database");
+        std::optional<CCoinsStats> maybe_stats;
+        try {
+            maybe_stats = ComputeUTXOStats(
+                CoinStatsHashType::HASH_SERIALIZED, snapshot_coinsdb, m_blockman, [&interrupt = m_interrupt] { SnapshotUTXOHashBreakpoint(interrupt); });
+        } catch (StopHashingException const&) {
+            return util::Error{Untranslated("Aborting after an interrupt was requested")};
+        }
+        if (!maybe_stats.has_value()) {
+            return util::Error{Untranslated("Failed to generate coins stats")};
+        }
+        hash_serialized = maybe_stats->hashSerialized;
     }
 
     // Assert that the deserialized chainstate contents match the expected assumeutxo value.
-    if (AssumeutxoHash{maybe_stats->hashSerialized} != au_data.hash_serialized) {
+    if (AssumeutxoHash{*hash_serialized} != au_data.hash_serialized) {
         return util::Error{Untranslated(strprintf("Bad snapshot content hash: expected %s, got %s",
-            au_data.hash_serialized.ToString(), maybe_stats->hashSerialized.ToString()))};
+            au_data.hash_serialized.ToString(), hash_serialized->ToString()))};
     }
 
     snapshot_chainstate.m_chain.SetTip(*snapshot_start_block);
@@ -6152,7 +6277,9 @@ static ChainstateManager::Options&& Flatten(ChainstateManager::Options&& opts)
 }
 
 ChainstateManager::ChainstateManager(const util::SignalInterrupt& interrupt, Options options, node::BlockManager::Options blockman_options)
-    : m_script_check_queue{/*batch_size=*/128, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS)},
+    : m_script_check_queue{/*batch_size=*/128, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS),
+                           options.script_check_work_stealing ? CheckQueueScheduler::WORK_STEALING : CheckQueueScheduler::SHARED_QUEUE},
+      m_input_fetcher{std::clamp(options.input_fetch_threads_num, 0, MAX_INPUT_FETCH_THREADS)},
       m_interrupt{interrupt},
       m_options{Flatten(std::move(options))},
       m_blockman{interrupt, std::move(blockman_options)},
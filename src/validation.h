@@ -11,9 +11,11 @@
 #include <chain.h>
 #include <checkqueue.h>
 #include <coins.h>
+#include <coinsasyncflush.h>
 #include <consensus/amount.h>
 #include <cuckoocache.h>
 #include <deploymentstatus.h>
+#include <inputfetcher.h>
 #include <kernel/chain.h>
 #include <kernel/chainparams.h>
 #include <kernel/chainstatemanager_opts.h>
@@ -59,6 +61,7 @@ class DisconnectedBlockTransactions;
 struct PrecomputedTransactionData;
 struct LockPoints;
 struct AssumeutxoData;
+class ThreadPool;
 namespace kernel {
 struct ChainstateRole;
 } // namespace kernel
@@ -89,6 +92,9 @@ static const uint64_t MIN_DISK_SPACE_FOR_BLOCK_FILES = 550 * 1024 * 1024;
 /** Maximum number of dedicated script-checking threads allowed */
 static constexpr int MAX_SCRIPTCHECK_THREADS{15};
 
+/** Maximum number of block input prefetching threads allowed */
+static constexpr int MAX_INPUT_FETCH_THREADS{64};
+
 /** Current sync state passed to tip changed callbacks. */
 enum class SynchronizationState {
     INIT_REINDEX,
@@ -370,6 +376,8 @@ static_assert(std::is_nothrow_destructible_v<CScriptCheck>);
 class ValidationCache
 {
 private:
+    //! Salt of the script execution cache entries.
+    uint256 m_script_execution_cache_nonce;
     //! Pre-initialized hasher to avoid having to recreate it for every hash calculation.
     CSHA256 m_script_execution_cache_hasher;
 
@@ -384,6 +392,15 @@ public:
 
     //! Return a copy of the pre-initialized hasher.
     CSHA256 ScriptExecutionCacheHasher() const { return m_script_execution_cache_hasher; }
+
+    uint256 ScriptExecutionCacheNonce() const { return m_script_execution_cache_nonce; }
+
+    /**
+     * Replace the salt of the script execution cache, so that entries persisted
+     * by a previous run can be inserted. Must not be called while scripts are
+     * being checked against the cache.
+     */
+    void SetScriptExecutionCacheNonce(const uint256& nonce);
 };
 
 /** Functions for validating blocks and updating the block tree */
@@ -481,10 +498,20 @@ class CoinsViews {
 public:
     //! The lowest level of the CoinsViews cache hierarchy sits in a leveldb database on disk.
     //! All unspent coins reside in this store.
-    CCoinsViewDB m_dbview GUARDED_BY(cs_main);
+    //!
+    //! Not guarded by cs_main: m_asyncview's writer thread writes to it through
+    //! m_catcherview without holding cs_main. Other users reach it through
+    //! Chainstate::CoinsDB(), which requires cs_main and waits for that write first.
+    CCoinsViewDB m_dbview;
 
     //! This view wraps access to the leveldb instance and handles read errors gracefully.
-    CCoinsViewErrorCatcher m_catcherview GUARDED_BY(cs_main);
+    //! Not guarded by cs_main for the same reason as m_dbview, see
+    //! Chainstate::CoinsErrorCatcher().
+    CCoinsViewErrorCatcher m_catcherview;
+
+    //! This view writes flushes of the cache to m_catcherview, on a background thread if
+    //! CoinsViewOptions::async_flush is set. Safe for concurrent reads.
+    CoinsViewAsyncFlush m_asyncview;
 
     //! This is the top layer of the cache hierarchy - it keeps as many coins in memory as
     //! can fit per the dbcache setting.
@@ -690,11 +717,14 @@ public:
         return *Assert(m_coins_views->m_cacheview);
     }
 
-    //! @returns A reference to the on-disk UTXO set database.
+    //! @returns A reference to the on-disk UTXO set database. Waits for any
+    //!     background flush of CoinsTip() to complete first, so the database
+    //!     reflects the last flush.
     CCoinsViewDB& CoinsDB() EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
     {
         AssertLockHeld(::cs_main);
-        return Assert(m_coins_views)->m_dbview;
+        Assert(m_coins_views)->m_asyncview.WaitForFlush();
+        return m_coins_views->m_dbview;
     }
 
     //! @returns A pointer to the mempool.
@@ -704,11 +734,13 @@ public:
     }
 
     //! @returns A reference to a wrapped view of the in-memory UTXO set that
-    //!     handles disk read errors gracefully.
+    //!     handles disk read errors gracefully. Waits for any background flush
+    //!     of CoinsTip() to complete first, as it is used by that flush.
     CCoinsViewErrorCatcher& CoinsErrorCatcher() EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
     {
         AssertLockHeld(::cs_main);
-        return Assert(m_coins_views)->m_catcherview;
+        Assert(m_coins_views)->m_asyncview.WaitForFlush();
+        return m_coins_views->m_catcherview;
     }
 
     //! Destructs all objects related to accessing the UTXO set.
@@ -856,6 +888,7 @@ protected:
         BlockValidationState& state,
         CBlockIndex* pindexNew,
         std::shared_ptr<const CBlock> block_to_connect,
+        const CBlockIndex* pindex_next,
         ConnectTrace& connectTrace,
         DisconnectedBlockTransactions& disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
 
@@ -977,6 +1010,9 @@ private:
     //! A queue for script verifications that have to be performed by worker threads.
     CCheckQueue<CScriptCheck> m_script_check_queue;
 
+    //! Thread pool warming the coins cache with the inputs of blocks about to be connected.
+    InputFetcher m_input_fetcher;
+
     //! Timers and counters used for benchmarking validation in both background
     //! and active chainstates.
     SteadyClock::duration GUARDED_BY(::cs_main) time_check{};
@@ -1216,17 +1252,22 @@ public:
      * This function can also be used to read blocks from user-specified block files using the
      * -loadblock= option. There's no unknown-parent tracking, so the last two arguments are omitted.
      *
+     * Blocks are deserialized and hashed ahead of time on the worker threads of the pool, if
+     * one is given, and processed in the order they appear in the file.
      *
      * @param[in]     file_in                       File containing blocks to read
      * @param[in]     dbp                           (optional) Disk block position (only for reindex)
      * @param[in,out] blocks_with_unknown_parent    (optional) Map of disk positions for blocks with
      *                                              unknown parent, key is parent block hash
      *                                              (only used for reindex)
+     * @param[in]     pool                          (optional) Started thread pool to deserialize
+     *                                              blocks on, shared across files
      * */
     void LoadExternalBlockFile(
         AutoFile& file_in,
         FlatFilePos* dbp = nullptr,
-        std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent = nullptr);
+        std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent = nullptr,
+        ThreadPool* pool = nullptr);
 
     /**
      * Process an incoming block. This only returns after the best known valid
@@ -1364,6 +1405,7 @@ public:
     std::optional<int> BlocksAheadOfTip() const LOCKS_EXCLUDED(::cs_main);
 
     CCheckQueue<CScriptCheck>& GetCheckQueue() { return m_script_check_queue; }
+    InputFetcher& GetInputFetcher() { return m_input_fetcher; }
 
     ~ChainstateManager();
 
@@ -71,6 +71,11 @@ class DumptxoutsetTest(BitcoinTestFramework):
         assert_raises_rpc_error(
             -8, 'Invalid snapshot type "bogus" specified. Please specify "rollback" or "latest"', node.dumptxoutset, 'utxos.dat', "bogus")
 
+        self.log.info("Test that dumptxoutset with an unsupported version fails, also when it would wrap to a supported one")
+        for version in [0, 65538]:
+            assert_raises_rpc_error(
+                -8, f"Unsupported snapshot version {version}", node.dumptxoutset, 'utxos.dat', "latest", version=version)
+
         self.log.info("Test that dumptxoutset failure does not leave the network activity suspended when it was on previously")
         self.check_expected_network(node, True)
 